@@ -0,0 +1,49 @@
+#pragma once
+
+#include <chrono>
+#include <cstdio>
+#include <utility>
+
+namespace sundry::bench {  // namespace sundry::bench
+  /**
+   * @brief Runs \p func once and returns elapsed wall time in seconds.
+   */
+  template<typename F>
+  double measure(F &&func) {
+    auto start = std::chrono::steady_clock::now();
+    std::forward<F>(func)();
+    std::chrono::duration<double> elapsed =
+        std::chrono::steady_clock::now() - start;
+    return elapsed.count();
+  }
+
+  /**
+   * @brief Prints a single benchmark row as `name: <ops/s> Mops/s`.
+   *
+   * @param[in] name benchmark label.
+   * @param[in] ops number of operations performed.
+   * @param[in] seconds elapsed time.
+   */
+  inline void report(const char *name, double ops, double seconds) {
+    std::printf("%-40s %10.2f Mops/s\n", name, ops / seconds / 1e6);
+  }
+
+  /**
+   * @brief Prints a single benchmark row as `name: <bytes/s> GB/s`.
+   *
+   * @param[in] name benchmark label.
+   * @param[in] bytes number of bytes processed.
+   * @param[in] seconds elapsed time.
+   */
+  inline void report_bytes(const char *name, double bytes, double seconds) {
+    std::printf("%-40s %10.2f GB/s\n", name, bytes / seconds / 1e9);
+  }
+
+  /**
+   * @brief Prevents the compiler from optimizing \p value away.
+   */
+  template<typename T>
+  inline void do_not_optimize(T const &value) {
+    asm volatile("" : : "r,m"(value) : "memory");
+  }
+}  // namespace sundry::bench
@@ -0,0 +1,159 @@
+#include "bench.hpp"
+#include "channel.hpp"
+
+#include <atomic>
+#include <cstdio>
+#include <deque>
+#include <iterator>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+
+using namespace sundry;
+
+namespace {
+  using Item = Result<long, int>;
+
+  constexpr long items = 4'000'000;
+  constexpr std::size_t capacity = 1024;
+
+  /// Baseline: mutex-guarded queue, as used before the channel existed.
+  struct MutexQueue {
+    std::mutex mutex;
+    std::deque<Item> queue;
+    bool closed = false;
+
+    bool push(Item value) {
+      std::lock_guard lock(mutex);
+      if(queue.size() >= capacity) return false;
+      queue.push_back(std::move(value));
+      return true;
+    }
+
+    std::size_t pop_n(std::vector<Item> &out, std::size_t max) {
+      std::lock_guard lock(mutex);
+      std::size_t n = 0;
+      for(; n < max && !queue.empty(); ++n) {
+        out.push_back(std::move(queue.front()));
+        queue.pop_front();
+      }
+      return n;
+    }
+
+    bool drained() {
+      std::lock_guard lock(mutex);
+      return closed && queue.empty();
+    }
+
+    void close() {
+      std::lock_guard lock(mutex);
+      closed = true;
+    }
+  };
+
+  /**
+   * @brief Moves `items` results from \p producers to \p consumers threads
+   * through \p Channel, pushing and popping \p batch values at a time.
+   */
+  template<typename Channel>
+  double run(int producers, int consumers, std::size_t batch) {
+    Channel channel(capacity);
+    std::atomic<int> done {0};
+    std::atomic<long> received {0};
+    std::vector<std::thread> threads;
+    return bench::measure([&] {
+      for(int p = 0; p < producers; ++p)
+        threads.emplace_back([&, p] {
+          std::vector<Item> buffer;
+          auto share = items / producers;
+          for(long i = 0; i < share; i += (long) batch) {
+            buffer.clear();
+            for(long j = i; j < i + (long) batch && j < share; ++j)
+              buffer.push_back(j % 64 ? Item(Ok<long> {j})
+                                      : Item(Err<int> {1}));
+            std::size_t sent = 0;
+            while(sent < buffer.size()) {
+              auto n = channel.try_push_n(buffer.begin() + sent,
+                                          buffer.size() - sent);
+              if(n == 0) std::this_thread::yield();
+              sent += n;
+            }
+          }
+          if(++done == producers) channel.close();
+        });
+      for(int c = 0; c < consumers; ++c)
+        threads.emplace_back([&] {
+          std::vector<Item> out;
+          out.reserve(batch);
+          long local = 0;
+          for(;;) {
+            out.clear();
+            auto n = channel.try_pop_n(std::back_inserter(out), batch);
+            local += (long) n;
+            if(n == 0) {
+              if(channel.poll() == ChannelStatus::closed) break;
+              std::this_thread::yield();
+            }
+            for(auto &r : out) bench::do_not_optimize(r.is_ok());
+          }
+          received += local;
+        });
+      for(auto &t : threads) t.join();
+    });
+  }
+
+  double run_mutex(int producers, int consumers, std::size_t batch) {
+    MutexQueue queue;
+    std::atomic<int> done {0};
+    std::vector<std::thread> threads;
+    return bench::measure([&] {
+      for(int p = 0; p < producers; ++p)
+        threads.emplace_back([&] {
+          auto share = items / producers;
+          for(long i = 0; i < share; ++i) {
+            Item item = i % 64 ? Item(Ok<long> {i}) : Item(Err<int> {1});
+            while(!queue.push(item)) std::this_thread::yield();
+          }
+          if(++done == producers) queue.close();
+        });
+      for(int c = 0; c < consumers; ++c)
+        threads.emplace_back([&] {
+          std::vector<Item> out;
+          for(;;) {
+            out.clear();
+            if(queue.pop_n(out, batch) == 0) {
+              if(queue.drained()) break;
+              std::this_thread::yield();
+            }
+            for(auto &r : out) bench::do_not_optimize(r.is_ok());
+          }
+        });
+      for(auto &t : threads) t.join();
+    });
+  }
+}  // namespace
+
+int main() {
+  char name[64];
+  for(std::size_t batch : {1, 32}) {
+    std::snprintf(name, sizeof name, "spsc 1x1 batch=%zu", batch);
+    bench::report(name, items, run<SpscChannel<long, int>>(1, 1, batch));
+    std::snprintf(name, sizeof name, "spsc 1x1 unpadded batch=%zu", batch);
+    bench::report(name, items,
+                  run<SpscChannel<long, int, false>>(1, 1, batch));
+    for(int threads : {1, 2, 4}) {
+      std::snprintf(name, sizeof name, "mpmc %dx%d batch=%zu", threads,
+                    threads, batch);
+      bench::report(name, items,
+                    run<MpmcChannel<long, int>>(threads, threads, batch));
+      std::snprintf(name, sizeof name, "mpmc %dx%d unpadded batch=%zu",
+                    threads, threads, batch);
+      bench::report(name, items, run<MpmcChannel<long, int, false>>(
+                                     threads, threads, batch));
+      std::snprintf(name, sizeof name, "mutex queue %dx%d batch=%zu",
+                    threads, threads, batch);
+      bench::report(name, items, run_mutex(threads, threads, batch));
+    }
+  }
+}
@@ -0,0 +1,125 @@
+#include "bench.hpp"
+#include "error_log.hpp"
+
+#include <cstdio>
+#include <mutex>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <time.h>
+
+using namespace sundry;
+
+namespace {
+  constexpr std::size_t count = 1'000'000;
+
+  /// Random results, a quarter of which hold errors.
+  std::vector<Result<int, int>> make_results() {
+    std::mt19937_64 rng(42);
+    std::uniform_int_distribution<int> ints(-1'000'000, 1'000'000);
+    std::bernoulli_distribution broken(0.25);
+    std::vector<Result<int, int>> results;
+    results.reserve(count);
+    for(std::size_t i = 0; i < count; ++i) {
+      if(broken(rng))
+        results.emplace_back(in_place_err, ints(rng));
+      else
+        results.emplace_back(in_place_ok, ints(rng));
+    }
+    return results;
+  }
+
+  /// Conventional logger: formats and writes under a lock on the caller.
+  struct SyncLog {
+    std::FILE *file;
+    std::mutex mutex;
+
+    void log(const Err<int> &error, std::source_location site) {
+      std::ostringstream os;
+      os << site.file_name() << ':' << site.line() << ' '
+         << site.function_name() << ": Err(" << error.value << ")\n";
+      auto text = os.str();
+      std::lock_guard lock(mutex);
+      std::fwrite(text.data(), 1, text.size(), file);
+    }
+  };
+
+  std::int64_t coarse_time() noexcept {
+    timespec now;
+    clock_gettime(CLOCK_REALTIME_COARSE, &now);
+    return now.tv_sec * 1'000'000'000LL + now.tv_nsec;
+  }
+
+  template<typename S>
+  void run(const char *name, const std::vector<Result<int, int>> &values,
+           S &sink) {
+    auto seconds = bench::measure([&] {
+      for(auto &r : values) r.log_if_err(sink);
+    });
+    bench::report(name, values.size(), seconds);
+  }
+}  // namespace
+
+int main() {
+  auto values = make_results();
+  std::vector<Result<int, int>> oks, errs;
+  for(auto &r : values) (r.is_ok() ? oks : errs).push_back(r);
+  auto null = std::fopen("/dev/null", "w");
+  auto writer = [null](std::string_view text) {
+    std::fwrite(text.data(), 1, text.size(), null);
+  };
+
+  SyncLog sync {null};
+  std::printf("-- Err only\n");
+  run("synchronous ostringstream + fwrite", errs, sync);
+  {
+    ErrorLogOptions options;
+    options.capacity = 1 << 12;
+    ErrorLog log(writer, options);
+    run("ErrorLog, drop on full", errs, log);
+    log.flush();
+    auto stats = log.stats();
+    std::printf("  (written %llu, dropped %llu)\n",
+                static_cast<unsigned long long>(stats.written),
+                static_cast<unsigned long long>(stats.dropped));
+  }
+  {
+    ErrorLogOptions options;
+    options.capacity = 1 << 12;
+    options.clock = &coarse_time;
+    ErrorLog log(writer, options);
+    run("ErrorLog, drop on full, coarse clock", errs, log);
+  }
+  {
+    ErrorLogOptions options;
+    options.capacity = 1 << 10;
+    options.overflow = Overflow::block;
+    ErrorLog log(writer, options);
+    run("ErrorLog, block on full", errs, log);
+  }
+  {
+    ErrorLogOptions options;
+    options.rate = 1000;
+    ErrorLog log(writer, options);
+    run("ErrorLog, rate limited", errs, log);
+  }
+
+  std::printf("-- Ok only\n");
+  run("synchronous ostringstream + fwrite", oks, sync);
+  {
+    ErrorLog log(writer);
+    run("ErrorLog", oks, log);
+  }
+
+  std::printf("-- 25%% Err\n");
+  run("synchronous ostringstream + fwrite", values, sync);
+  {
+    ErrorLogOptions options;
+    options.capacity = 1 << 12;
+    ErrorLog log(writer, options);
+    run("ErrorLog, drop on full", values, log);
+  }
+  std::fclose(null);
+}
@@ -0,0 +1,79 @@
+#include "bench.hpp"
+#include "result.hpp"
+
+#include <array>
+#include <cstdio>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace sundry;
+
+namespace {
+  constexpr std::size_t count = 1'000'000;
+
+  /// Random results, a quarter of which hold errors.
+  template<typename T>
+  std::vector<Result<T, int>> make_results() {
+    std::mt19937_64 rng(42);
+    std::uniform_int_distribution<int> ints(-1'000'000, 1'000'000);
+    std::bernoulli_distribution broken(0.25);
+    std::vector<Result<T, int>> results;
+    results.reserve(count);
+    for(std::size_t i = 0; i < count; ++i) {
+      if(broken(rng))
+        results.emplace_back(in_place_err, ints(rng));
+      else
+        results.emplace_back(in_place_ok, static_cast<T>(ints(rng)) / 7);
+    }
+    return results;
+  }
+
+  template<typename F>
+  void run(const char *name, F &&func) {
+    std::size_t sink = func();  // warm-up
+    auto seconds = bench::measure([&] { sink = func(); });
+    bench::do_not_optimize(sink);
+    bench::report(name, count, seconds);
+  }
+
+  template<typename T>
+  void results(const char *type) {
+    auto values = make_results<T>();
+    std::printf("-- Result<%s, int>\n", type);
+    run("std::ostringstream", [&] {
+      std::size_t size = 0;
+      for(auto &r : values) {
+        std::ostringstream os;
+        if(r.is_ok())
+          os << "Ok(" << r.ok_value_.value << ')';
+        else
+          os << "Err(" << r.err_value_.value << ')';
+        size += os.str().size();
+      }
+      return size;
+    });
+    run("sundry::format_to(std::string)", [&] {
+      std::size_t size = 0;
+      std::string out;
+      for(auto &r : values) {
+        out.clear();
+        sundry::format_to(std::back_inserter(out), r);
+        size += out.size();
+      }
+      return size;
+    });
+    run("sundry::format_into(char[64])", [&] {
+      std::size_t size = 0;
+      std::array<char, 64> buffer;
+      for(auto &r : values) size += format_into(buffer, r).ok_value_.value;
+      return size;
+    });
+  }
+}  // namespace
+
+int main() {
+  results<int>("int");
+  results<double>("double");
+}
@@ -0,0 +1,88 @@
+#include "bench.hpp"
+#include "interop.hpp"
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+using namespace sundry;
+
+namespace {
+  constexpr std::size_t count = 2'000'000;
+
+  template<typename T>
+  std::vector<Result<T, int>> make_results(const T &payload) {
+    std::vector<Result<T, int>> results;
+    results.reserve(count);
+    for(std::size_t i = 0; i < count; ++i) {
+      if(i % 8)
+        results.emplace_back(in_place_ok, payload);
+      else
+        results.emplace_back(in_place_err, static_cast<int>(i));
+    }
+    return results;
+  }
+
+  /// Runs \p func over a fresh copy of \p source, so moves have something
+  /// to steal; the copy is not measured.
+  template<typename T, typename F>
+  void run(const char *name, const std::vector<Result<T, int>> &source,
+           F &&func) {
+    auto values = source;
+    std::size_t sink = 0;
+    auto seconds = bench::measure([&] {
+      for(auto &value : values) sink += func(value);
+    });
+    bench::do_not_optimize(sink);
+    bench::report(name, count, seconds);
+  }
+
+  void strings() {
+    auto source = make_results(std::string(64, 'x'));
+    std::printf("-- Result<std::string, int>\n");
+    run("ok() const & (copy)", source, [](auto &r) {
+      auto ok = r.ok();
+      return ok ? ok->size() : 0;
+    });
+    run("ok() && (move)", source, [](auto &r) {
+      auto ok = std::move(r).ok();
+      return ok ? ok->size() : 0;
+    });
+    run("ok_ptr() (reference)", source, [](auto &r) {
+      auto ok = r.ok_ptr();
+      return ok ? ok->size() : 0;
+    });
+    run("to_variant/from_variant (copy)", source, [](auto &r) {
+      auto back = from_variant(to_variant(r));
+      return back.is_ok() ? back.ok_value_.value.size() : 0;
+    });
+    run("to_variant/from_variant (move)", source, [](auto &r) {
+      auto back = from_variant(to_variant(std::move(r)));
+      return back.is_ok() ? back.ok_value_.value.size() : 0;
+    });
+  }
+
+  void integers() {
+    auto source = make_results(42L);
+    std::printf("-- Result<long, int>\n");
+    // Both alternatives are read back, so that the baseline is not
+    // optimized down to a single load.
+    run("plain copy (baseline)", source, [](auto &r) {
+      auto copy = r;
+      bench::do_not_optimize(copy.is_ok() ? copy.ok_value_.value
+                                            : copy.err_value_.value);
+      return std::size_t(copy.is_ok());
+    });
+    run("to_variant/from_variant", source, [](auto &r) {
+      auto back = from_variant(to_variant(r));
+      bench::do_not_optimize(back.is_ok() ? back.ok_value_.value
+                                            : back.err_value_.value);
+      return std::size_t(back.is_ok());
+    });
+  }
+}  // namespace
+
+int main() {
+  strings();
+  integers();
+}
@@ -0,0 +1,130 @@
+#include "bench.hpp"
+#include "parse.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace sundry;
+
+namespace {
+  constexpr std::size_t count = 2'000'000;
+
+  /// Random fields, \p error_rate of which are not numbers.
+  std::vector<std::string> make_fields(bool floating, double error_rate) {
+    std::mt19937_64 rng(42);
+    std::uniform_int_distribution<int> ints(-1'000'000'000, 1'000'000'000);
+    std::uniform_real_distribution<double> reals(-1e6, 1e6);
+    std::bernoulli_distribution broken(error_rate);
+    std::vector<std::string> fields;
+    fields.reserve(count);
+    for(std::size_t i = 0; i < count; ++i) {
+      if(broken(rng))
+        fields.push_back("12ab");
+      else if(floating)
+        fields.push_back(std::to_string(reals(rng)));
+      else
+        fields.push_back(std::to_string(ints(rng)));
+    }
+    return fields;
+  }
+
+  std::string join(const std::vector<std::string> &fields) {
+    std::string buffer;
+    for(auto &f : fields) (buffer += f) += '\n';
+    return buffer;
+  }
+
+  template<typename F>
+  void run(const char *name, F &&func) {
+    long long sink = func();  // warm-up: caches and column capacity
+    auto seconds = bench::measure([&] { sink = func(); });
+    bench::do_not_optimize(sink);
+    bench::report(name, count, seconds);
+  }
+
+  void integers(double error_rate) {
+    auto fields = make_fields(false, error_rate);
+    auto buffer = join(fields);
+    std::printf("-- int, %.0f%% invalid\n", error_rate * 100);
+    run("parse::number<int>", [&] {
+      long long sum = 0;
+      for(auto &f : fields) {
+        auto r = parse::number<int>(f);
+        if(r.is_ok()) sum += r.ok_value_.value;
+      }
+      return sum;
+    });
+    parse::Column<int> column;
+    run("parse::column<int>", [&] {
+      parse::column(buffer, '\n', column);
+      long long sum = 0;
+      for(auto v : column.values) sum += v;
+      return sum;
+    });
+    run("std::stoi + exceptions", [&] {
+      long long sum = 0;
+      for(auto &f : fields) {
+        try {
+          std::size_t pos;
+          auto v = std::stoi(f, &pos);
+          if(pos != f.size()) throw std::invalid_argument("trailing");
+          sum += v;
+        } catch(const std::exception &) {}
+      }
+      return sum;
+    });
+  }
+
+  void doubles(double error_rate) {
+    auto fields = make_fields(true, error_rate);
+    auto buffer = join(fields);
+    std::printf("-- double, %.0f%% invalid\n", error_rate * 100);
+    run("parse::number<double>", [&] {
+      double sum = 0;
+      for(auto &f : fields) {
+        auto r = parse::number<double>(f);
+        if(r.is_ok()) sum += r.ok_value_.value;
+      }
+      return (long long) sum;
+    });
+    parse::Column<double> column;
+    run("parse::column<double>", [&] {
+      parse::column(buffer, '\n', column);
+      double sum = 0;
+      for(auto v : column.values) sum += v;
+      return (long long) sum;
+    });
+    run("std::stod + exceptions", [&] {
+      double sum = 0;
+      for(auto &f : fields) {
+        try {
+          std::size_t pos;
+          auto v = std::stod(f, &pos);
+          if(pos != f.size()) throw std::invalid_argument("trailing");
+          sum += v;
+        } catch(const std::exception &) {}
+      }
+      return (long long) sum;
+    });
+    run("strtod", [&] {
+      double sum = 0;
+      for(auto &f : fields) {
+        char *end;
+        auto v = std::strtod(f.c_str(), &end);
+        if(end == f.c_str() + f.size()) sum += v;
+      }
+      return (long long) sum;
+    });
+  }
+}  // namespace
+
+int main() {
+  for(double error_rate : {0.0, 0.05}) {
+    integers(error_rate);
+    doubles(error_rate);
+  }
+}
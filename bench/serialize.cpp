@@ -0,0 +1,166 @@
+#include "bench.hpp"
+#include "serialize.hpp"
+
+#include <cstdio>
+#include <cstring>
+#include <iterator>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace sundry;
+
+namespace {
+  constexpr std::size_t count = 4'000'000;
+
+  struct Sample {
+    std::int64_t id;
+    double value;
+  };
+
+  /// Random results, a tenth of which hold errors.
+  template<typename T>
+  std::vector<Result<T, std::int32_t>> make_results() {
+    std::mt19937_64 rng(42);
+    std::bernoulli_distribution broken(0.1);
+    std::uniform_int_distribution<int> lengths(0, 32);
+    std::vector<Result<T, std::int32_t>> results;
+    results.reserve(count);
+    for(std::size_t i = 0; i < count; ++i) {
+      if(broken(rng))
+        results.emplace_back(in_place_err, static_cast<std::int32_t>(i));
+      else if constexpr(std::is_same_v<T, std::string>)
+        results.emplace_back(in_place_ok, std::string(lengths(rng), 'x'));
+      else
+        results.emplace_back(in_place_ok, Sample {std::int64_t(i), i * 0.5});
+    }
+    return results;
+  }
+
+  /// Hand-rolled baseline: every field appended and read back separately,
+  /// with a bounds check per field.
+  namespace naive {
+    template<typename V>
+    void put(std::vector<std::byte> &out, const V &value) {
+      auto p = reinterpret_cast<const std::byte *>(&value);
+      out.insert(out.end(), p, p + sizeof value);
+    }
+
+    void put(std::vector<std::byte> &out, const std::string &value) {
+      put(out, static_cast<std::uint32_t>(value.size()));
+      auto p = reinterpret_cast<const std::byte *>(value.data());
+      out.insert(out.end(), p, p + value.size());
+    }
+
+    void put(std::vector<std::byte> &out, const Sample &value) {
+      put(out, value.id);
+      put(out, value.value);
+    }
+
+    struct Reader {
+      const std::vector<std::byte> &in;
+      std::size_t pos = 0;
+
+      template<typename V>
+      V get() {
+        if(pos + sizeof(V) > in.size()) throw std::runtime_error("truncated");
+        V value;
+        std::memcpy(&value, in.data() + pos, sizeof value);
+        pos += sizeof value;
+        return value;
+      }
+
+      template<typename T>
+      T payload() {
+        if constexpr(std::is_same_v<T, std::string>) {
+          auto size = get<std::uint32_t>();
+          if(pos + size > in.size()) throw std::runtime_error("truncated");
+          std::string value(reinterpret_cast<const char *>(in.data() + pos),
+                            size);
+          pos += size;
+          return value;
+        } else {
+          auto id = get<std::int64_t>();
+          return Sample {id, get<double>()};
+        }
+      }
+    };
+
+    template<typename T>
+    void encode(const std::vector<Result<T, std::int32_t>> &values,
+                std::vector<std::byte> &out) {
+      for(auto &value : values) {
+        put(out, static_cast<std::uint8_t>(value.is_ok()));
+        if(value.is_ok())
+          put(out, value.ok_value_.value);
+        else
+          put(out, value.err_value_.value);
+      }
+    }
+
+    template<typename T>
+    void decode(const std::vector<std::byte> &in,
+                std::vector<Result<T, std::int32_t>> &out) {
+      Reader reader {in};
+      while(reader.pos != in.size()) {
+        if(reader.get<std::uint8_t>())
+          out.emplace_back(in_place_ok, reader.payload<T>());
+        else
+          out.emplace_back(in_place_err, reader.get<std::int32_t>());
+      }
+    }
+  }  // namespace naive
+
+  template<typename F>
+  void run(const char *name, std::size_t bytes, F &&func) {
+    func();  // warm-up: caches and buffer capacity
+    auto seconds = bench::measure(func);
+    bench::report_bytes(name, bytes, seconds);
+  }
+
+  template<typename T>
+  void results(const char *type) {
+    auto values = make_results<T>();
+    std::printf("-- Result<%s, int32_t>\n", type);
+    std::vector<std::byte> buffer;
+    naive::encode(values, buffer);
+    auto bytes = buffer.size();
+    run("naive per-field encode", bytes, [&] {
+      buffer.clear();
+      naive::encode(values, buffer);
+      bench::do_not_optimize(buffer.data());
+    });
+    serialize::Encoder<T, std::int32_t> encoder;
+    run("serialize::Encoder::push(span)", bytes, [&] {
+      encoder.clear();
+      encoder.push(values);
+      bench::do_not_optimize(encoder.bytes().data());
+    });
+    std::vector<Result<T, std::int32_t>> decoded;
+    decoded.reserve(count);
+    run("naive per-field decode", bytes, [&] {
+      decoded.clear();
+      naive::decode(buffer, decoded);
+      bench::do_not_optimize(decoded.size());
+    });
+    run("serialize::Decoder::feed", bytes, [&] {
+      decoded.clear();
+      serialize::Decoder<T, std::int32_t> decoder;
+      decoder.feed(encoder.bytes(), decoded);
+      bench::do_not_optimize(decoded.size());
+    });
+    run("serialize::BatchView (zero-copy)", bytes, [&] {
+      auto batch =
+          serialize::BatchView<T, std::int32_t>::parse(encoder.bytes());
+      std::size_t oks = 0;
+      for(auto record : batch.ok_value_.value) oks += record.is_ok();
+      bench::do_not_optimize(oks);
+    });
+  }
+}  // namespace
+
+int main() {
+  results<Sample>("Sample");
+  results<std::string>("std::string");
+}
@@ -0,0 +1,79 @@
+#include "bench.hpp"
+#include "try_invoke.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace sundry;
+
+namespace {
+  constexpr long calls = 200'000;  ///< Per thread.
+  constexpr int depth = 16;        ///< Frames between boundary and caller.
+
+  /// Third-party function failing on every other call.
+  [[gnu::noinline]] long third_party(long i) {
+    if(i & 1) throw std::invalid_argument("odd");
+    return i;
+  }
+
+  /// Legacy style: exception unwinds all frames up to the caller.
+  [[gnu::noinline]] long propagate(long i, int level) {
+    if(level == 0) return third_party(i);
+    auto value = propagate(i, level - 1);
+    bench::do_not_optimize(value);
+    return value;
+  }
+
+  /// Exception is caught at the boundary; an `Err` travels up instead.
+  template<Capture C>
+  [[gnu::noinline]] Result<long, CaughtError> boundary(long i, int level) {
+    if(level == 0) return try_invoke<C>(third_party, i);
+    auto value = boundary<C>(i, level - 1);
+    bench::do_not_optimize(value);
+    return value;
+  }
+
+  /// Runs \p func `calls` times on each of \p threads threads.
+  template<typename F>
+  void run(const char *name, int threads, F func) {
+    auto seconds = bench::measure([&] {
+      std::vector<std::thread> workers;
+      for(int t = 0; t < threads; ++t)
+        workers.emplace_back([&] {
+          long sum = 0;
+          for(long i = 0; i < calls; ++i) sum += func(i);
+          bench::do_not_optimize(sum);
+        });
+      for(auto &worker : workers) worker.join();
+    });
+    char label[64];
+    std::snprintf(label, sizeof label, "%s, %d threads", name, threads);
+    bench::report(label, double(calls) * threads, seconds);
+  }
+}  // namespace
+
+int main() {
+  // hardware_concurrency() may report 0 when the count is unknown.
+  auto hardware =
+      std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+  for(int threads = 1; threads <= hardware && threads <= 16; threads *= 2) {
+    run("exceptions propagate", threads, [](long i) -> long {
+      try {
+        return propagate(i, depth);
+      } catch(const std::exception &) {
+        return 0;
+      }
+    });
+    run("try_invoke at boundary", threads, [](long i) -> long {
+      auto r = boundary<Capture::kind>(i, depth);
+      return r.is_ok() ? r.ok_value_.value : 0;
+    });
+    run("try_invoke, Capture::exception", threads, [](long i) -> long {
+      auto r = boundary<Capture::exception>(i, depth);
+      return r.is_ok() ? r.ok_value_.value : 0;
+    });
+  }
+}
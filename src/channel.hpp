@@ -0,0 +1,635 @@
+#pragma once
+
+#include "result.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+namespace sundry {  // namespace sundry
+  /**
+   * @brief Assumed size of a cache line. Used to keep independently written
+   * atomics from sharing a line.
+   */
+  inline constexpr std::size_t cache_line_size = 64;
+
+  /**
+   * @brief Outcome of a channel operation.
+   */
+  enum class ChannelStatus : std::uint8_t {
+    ok,      ///< Operation succeeded / channel still holds values.
+    empty,   ///< Channel is open, but there is nothing to pop.
+    full,    ///< Channel has no free slots.
+    closed,  ///< Channel was closed cleanly.
+    failed,  ///< Channel was closed with an upstream error.
+  };
+
+  namespace detail {
+    /**
+     * @brief Atomic index, optionally occupying a whole cache line.
+     *
+     * @tparam Padded `true` to align (and thus pad) the index to
+     * `cache_line_size`.
+     */
+    template<bool Padded>
+    struct alignas(Padded ? cache_line_size : alignof(std::atomic<std::size_t>))
+        ChannelIndex {
+      std::atomic<std::size_t> value {0};
+    };
+
+    /**
+     * @brief Uninitialized storage for a single `Result<T, E>`.
+     */
+    template<typename T, typename E>
+    struct ChannelSlot {
+      // Values are moved out of slots while they are being released; a
+      // throwing move would leave a slot neither full nor free.
+      static_assert(std::is_nothrow_move_constructible_v<Result<T, E>>,
+                    "channels require nothrow move constructible payloads");
+
+      alignas(Result<T, E>) std::byte bytes[sizeof(Result<T, E>)];
+
+      Result<T, E> *get() noexcept {
+        return std::launder(reinterpret_cast<Result<T, E> *>(bytes));
+      }
+    };
+
+    /**
+     * @brief State shared by all channel flavours: capacity and close status.
+     *
+     * @tparam E Error value type of transported results, also used as the
+     * close error.
+     * @tparam Padded `true` to put the close state in its own cache line.
+     */
+    template<typename E, bool Padded>
+    class ChannelBase {
+     public:
+      /**
+       * @brief Closes channel cleanly. Values pushed before the call are still
+       * delivered.
+       *
+       * @return `true` if this call closed the channel.
+       * @return `false` if channel was already closed.
+       */
+      bool close() noexcept {
+        std::uint8_t expected = open_;
+        if(!state_.value.compare_exchange_strong(expected, closing_,
+                                                 std::memory_order_acq_rel))
+          return false;
+        state_.value.store(closed_, std::memory_order_release);
+        return true;
+      }
+
+      /**
+       * @brief Closes channel with an upstream error. Values pushed before
+       * the call are still delivered, after which consumers observe
+       * `ChannelStatus::failed`.
+       *
+       * @param[in] error error reported by `close_status()`.
+       * @return `true` if this call closed the channel.
+       * @return `false` if channel was already closed.
+       */
+      bool close(Err<E> error) {
+        std::uint8_t expected = open_;
+        if(!state_.value.compare_exchange_strong(expected, closing_,
+                                                 std::memory_order_acq_rel))
+          return false;
+        error_.emplace(std::move(error));
+        state_.value.store(failed_, std::memory_order_release);
+        return true;
+      }
+
+      /**
+       * @brief Checks if channel was closed, either cleanly or with an error.
+       */
+      bool is_closed() const noexcept {
+        return state_.value.load(std::memory_order_acquire) >= closed_;
+      }
+
+      /**
+       * @brief Returns the way channel was closed.
+       *
+       * @return `Ok<void>` if channel was closed cleanly; `Err<E>` with the
+       * error passed to `close(Err<E>)` otherwise.
+       * @throw `std::runtime_error` if channel is still open.
+       */
+      Result<void, E> close_status() const {
+        auto state = state_.value.load(std::memory_order_acquire);
+        if(state < closed_)
+          throw std::runtime_error(
+              "called `close_status()` on a channel which is still open");
+        if(state == failed_) return {*error_};
+        return {Ok<void> {}};
+      }
+
+      /**
+       * @brief Maximal number of values channel can hold.
+       */
+      std::size_t capacity() const noexcept { return mask_ + 1; }
+
+     protected:
+      explicit ChannelBase(std::size_t capacity) : mask_(capacity - 1) {
+        if(capacity == 0 || (capacity & mask_) != 0)
+          throw std::invalid_argument(
+              "channel capacity must be a non-zero power of two");
+      }
+
+      bool accepts_pushes() const noexcept {
+        return state_.value.load(std::memory_order_relaxed) == open_;
+      }
+
+      /// Status reported to consumers once no values are left.
+      ChannelStatus drained_status() const noexcept {
+        switch(state_.value.load(std::memory_order_acquire)) {
+          case closed_:
+            return ChannelStatus::closed;
+          case failed_:
+            return ChannelStatus::failed;
+          default:
+            return ChannelStatus::empty;
+        }
+      }
+
+      const std::size_t mask_;
+
+     private:
+      static constexpr std::uint8_t open_ = 0;
+      static constexpr std::uint8_t closing_ = 1;
+      static constexpr std::uint8_t closed_ = 2;
+      static constexpr std::uint8_t failed_ = 3;
+
+      struct alignas(Padded ? cache_line_size : 1) State {
+        std::atomic<std::uint8_t> value {open_};
+      } state_;
+      std::optional<Err<E>> error_;
+    };
+  }  // namespace detail
+
+  /**
+   * @brief Bounded lock-free single-producer/single-consumer channel of
+   * `Result<T, E>`.
+   *
+   * Closing is expected to happen after the producer is done pushing (e.g. by
+   * the producer itself); values pushed concurrently with `close` may be
+   * rejected.
+   *
+   * @tparam T Ok value type.
+   * @tparam E Error value type.
+   * @tparam Padded `true` to put head, tail and close state in separate cache
+   * lines; `false` for a compact layout.
+   */
+  template<typename T, typename E, bool Padded = true>
+  class SpscChannel : public detail::ChannelBase<E, Padded> {
+    using Base = detail::ChannelBase<E, Padded>;
+    using Slot = detail::ChannelSlot<T, E>;
+    using Base::mask_;
+
+   public:
+    using value_t = Result<T, E>;  ///< Alias for transported type.
+
+    /**
+     * @brief Creates channel.
+     *
+     * @param[in] capacity number of slots; must be a power of two.
+     * @throw `std::invalid_argument` if \p capacity is not a power of two.
+     */
+    explicit SpscChannel(std::size_t capacity)
+        : Base(capacity), slots_(new Slot[capacity]) {}
+
+    SpscChannel(const SpscChannel &) = delete;
+    SpscChannel &operator=(const SpscChannel &) = delete;
+
+    ~SpscChannel() {
+      auto tail = tail_.value.load(std::memory_order_relaxed);
+      for(auto i = head_.value.load(std::memory_order_relaxed); i != tail; ++i)
+        std::destroy_at(slots_[i & mask_].get());
+    }
+
+    /**
+     * @brief Attempts to push a single value. Producer side only.
+     *
+     * @param[in] value anything `Result<T, E>` is constructible from, e.g.
+     * `Ok<T>` or `Err<E>`. Left untouched if the push fails.
+     * @return `ChannelStatus::ok` on success, `ChannelStatus::full` if there is
+     * no room, `ChannelStatus::closed` if channel no longer accepts values.
+     */
+    template<typename R>
+    requires std::constructible_from<value_t, R &&> ChannelStatus
+    try_push(R &&value) {
+      if(!this->accepts_pushes()) return ChannelStatus::closed;
+      auto tail = tail_.value.load(std::memory_order_relaxed);
+      if(tail - head_cache_.value.load(std::memory_order_relaxed) > mask_) {
+        head_cache_.value.store(head_.value.load(std::memory_order_acquire),
+                                std::memory_order_relaxed);
+        if(tail - head_cache_.value.load(std::memory_order_relaxed) > mask_)
+          return ChannelStatus::full;
+      }
+      std::construct_at(slots_[tail & mask_].get(), std::forward<R>(value));
+      tail_.value.store(tail + 1, std::memory_order_release);
+      return ChannelStatus::ok;
+    }
+
+    /**
+     * @brief Pushes a single value, spinning while channel is full.
+     *
+     * @return `ChannelStatus::ok` or `ChannelStatus::closed`.
+     */
+    template<typename R>
+    requires std::constructible_from<value_t, R &&> ChannelStatus
+    push(R &&value) {
+      for(;;) {
+        auto status = try_push(std::forward<R>(value));
+        if(status != ChannelStatus::full) return status;
+        std::this_thread::yield();
+      }
+    }
+
+    /**
+     * @brief Moves up to \p n values from \p first into channel, publishing
+     * them with a single store. Producer side only.
+     *
+     * @param[in] first iterator to values convertible to `Result<T, E>`.
+     * @param[in] n number of available values.
+     * @return number of values pushed; `0` if channel is full or closed.
+     * @throw anything converting a value throws; values before it are pushed.
+     */
+    template<std::input_iterator It>
+    std::size_t try_push_n(It first, std::size_t n) {
+      if(!this->accepts_pushes()) return 0;
+      auto tail = tail_.value.load(std::memory_order_relaxed);
+      auto free = capacity_left(tail, n);
+      std::size_t i = 0;
+      try {
+        for(; i < free; ++i, ++first)
+          std::construct_at(slots_[(tail + i) & mask_].get(),
+                            std::move(*first));
+      } catch(...) {
+        // Values constructed so far stay pushed.
+        if(i) tail_.value.store(tail + i, std::memory_order_release);
+        throw;
+      }
+      if(free) tail_.value.store(tail + free, std::memory_order_release);
+      return free;
+    }
+
+    /**
+     * @brief Attempts to pop a single value. Consumer side only.
+     *
+     * @return popped value; empty if nothing is available (see `poll()`).
+     */
+    std::optional<value_t> try_pop() {
+      std::optional<value_t> out;
+      try_pop_n(OptionalSink {&out}, 1);
+      return out;
+    }
+
+    /**
+     * @brief Moves up to \p max values into \p out, releasing their slots
+     * with a single store. Consumer side only.
+     *
+     * @param[out] out output iterator accepting `Result<T, E>`.
+     * @param[in] max maximal number of values to pop.
+     * @return number of popped values; see `poll()` when it is `0`.
+     */
+    template<typename OutputIt>
+    std::size_t try_pop_n(OutputIt out, std::size_t max) {
+      auto head = head_.value.load(std::memory_order_relaxed);
+      auto available = tail_cache_.value.load(std::memory_order_relaxed) - head;
+      if(available < max) {
+        tail_cache_.value.store(tail_.value.load(std::memory_order_acquire),
+                                std::memory_order_relaxed);
+        available = tail_cache_.value.load(std::memory_order_relaxed) - head;
+      }
+      if(available > max) available = max;
+      std::size_t i = 0;
+      try {
+        for(; i < available; ++i) {
+          auto slot = slots_[(head + i) & mask_].get();
+          *out = std::move(*slot);
+          ++out;
+          std::destroy_at(slot);
+        }
+      } catch(...) {
+        // The value \p out rejected stays in the channel.
+        if(i) head_.value.store(head + i, std::memory_order_release);
+        throw;
+      }
+      if(available)
+        head_.value.store(head + available, std::memory_order_release);
+      return available;
+    }
+
+    /**
+     * @brief Reports whether consumer should keep popping.
+     *
+     * @return `ChannelStatus::ok` if values are pending,
+     * `ChannelStatus::empty` if channel is open and empty,
+     * `ChannelStatus::closed`/`ChannelStatus::failed` once channel is closed
+     * and drained.
+     */
+    ChannelStatus poll() const noexcept {
+      auto status = this->drained_status();
+      if(tail_.value.load(std::memory_order_acquire)
+         != head_.value.load(std::memory_order_relaxed))
+        return ChannelStatus::ok;
+      return status;
+    }
+
+   private:
+    /// Output iterator storing a single popped value into `std::optional`.
+    struct OptionalSink {
+      std::optional<value_t> *target;
+      OptionalSink &operator*() { return *this; }
+      OptionalSink &operator++() { return *this; }
+      OptionalSink &operator=(value_t &&value) {
+        target->emplace(std::move(value));
+        return *this;
+      }
+    };
+
+    std::size_t capacity_left(std::size_t tail, std::size_t wanted) {
+      auto cached = head_cache_.value.load(std::memory_order_relaxed);
+      if(mask_ + 1 - (tail - cached) < wanted) {
+        cached = head_.value.load(std::memory_order_acquire);
+        head_cache_.value.store(cached, std::memory_order_relaxed);
+      }
+      auto free = mask_ + 1 - (tail - cached);
+      return free < wanted ? free : wanted;
+    }
+
+    std::unique_ptr<Slot[]> slots_;
+    detail::ChannelIndex<Padded> head_;        ///< Written by consumer.
+    detail::ChannelIndex<Padded> tail_cache_;  ///< Consumer-local.
+    detail::ChannelIndex<Padded> tail_;        ///< Written by producer.
+    detail::ChannelIndex<Padded> head_cache_;  ///< Producer-local.
+  };
+
+  /**
+   * @brief Bounded lock-free multi-producer/multi-consumer channel of
+   * `Result<T, E>`.
+   *
+   * Every slot carries a sequence number telling whether it may be written or
+   * read on the current lap, so producers and consumers only contend on the
+   * tail and head counters respectively. Batch operations claim several slots
+   * with a single CAS.
+   *
+   * Closing is expected to happen after all producers are done pushing;
+   * values pushed concurrently with `close` may be rejected.
+   *
+   * If converting a pushed value throws, its claimed slot is published empty
+   * and skipped by consumers, so the channel keeps working.
+   *
+   * @tparam T Ok value type.
+   * @tparam E Error value type.
+   * @tparam Padded `true` to put head, tail and close state in separate cache
+   * lines; `false` for a compact layout.
+   */
+  template<typename T, typename E, bool Padded = true>
+  class MpmcChannel : public detail::ChannelBase<E, Padded> {
+    using Base = detail::ChannelBase<E, Padded>;
+    using Base::mask_;
+
+    struct Cell {
+      std::atomic<std::size_t> sequence;
+      bool filled;  ///< `false` if constructing the value threw.
+      detail::ChannelSlot<T, E> slot;
+    };
+
+   public:
+    using value_t = Result<T, E>;  ///< Alias for transported type.
+
+    /**
+     * @brief Creates channel.
+     *
+     * @param[in] capacity number of slots; must be a power of two.
+     * @throw `std::invalid_argument` if \p capacity is not a power of two.
+     */
+    explicit MpmcChannel(std::size_t capacity)
+        : Base(capacity), cells_(new Cell[capacity]) {
+      for(std::size_t i = 0; i < capacity; ++i) {
+        cells_[i].sequence.store(i, std::memory_order_relaxed);
+        cells_[i].filled = false;
+      }
+    }
+
+    MpmcChannel(const MpmcChannel &) = delete;
+    MpmcChannel &operator=(const MpmcChannel &) = delete;
+
+    ~MpmcChannel() {
+      auto tail = tail_.value.load(std::memory_order_relaxed);
+      for(auto i = head_.value.load(std::memory_order_relaxed); i != tail; ++i)
+        if(cells_[i & mask_].filled)
+          std::destroy_at(cells_[i & mask_].slot.get());
+    }
+
+    /**
+     * @brief Attempts to push a single value.
+     *
+     * @param[in] value anything `Result<T, E>` is constructible from, e.g.
+     * `Ok<T>` or `Err<E>`. Left untouched if the push fails.
+     * @return `ChannelStatus::ok` on success, `ChannelStatus::full` if there is
+     * no room, `ChannelStatus::closed` if channel no longer accepts values.
+     * @throw anything converting \p value throws; nothing is pushed then.
+     */
+    template<typename R>
+    requires std::constructible_from<value_t, R &&> ChannelStatus
+    try_push(R &&value) {
+      if(!this->accepts_pushes()) return ChannelStatus::closed;
+      std::size_t count = 1;
+      auto pos = claim(tail_, 0, count);
+      if(!pos) return ChannelStatus::full;
+      fill(*pos, 1, [&](value_t *slot) {
+        std::construct_at(slot, std::forward<R>(value));
+      });
+      return ChannelStatus::ok;
+    }
+
+    /**
+     * @brief Pushes a single value, spinning while channel is full.
+     *
+     * @return `ChannelStatus::ok` or `ChannelStatus::closed`.
+     */
+    template<typename R>
+    requires std::constructible_from<value_t, R &&> ChannelStatus
+    push(R &&value) {
+      for(;;) {
+        auto status = try_push(std::forward<R>(value));
+        if(status != ChannelStatus::full) return status;
+        std::this_thread::yield();
+      }
+    }
+
+    /**
+     * @brief Moves up to \p n values from \p first into consecutive slots
+     * claimed with a single CAS.
+     *
+     * @param[in] first iterator to values convertible to `Result<T, E>`.
+     * @param[in] n number of available values.
+     * @return number of values pushed; `0` if channel is full or closed.
+     * @throw anything converting a value throws; values before it are pushed.
+     */
+    template<std::input_iterator It>
+    std::size_t try_push_n(It first, std::size_t n) {
+      if(n == 0 || !this->accepts_pushes()) return 0;
+      std::size_t count = n;
+      auto pos = claim(tail_, 0, count);
+      if(!pos) return 0;
+      fill(*pos, count, [&](value_t *slot) {
+        std::construct_at(slot, std::move(*first));
+        ++first;
+      });
+      return count;
+    }
+
+    /**
+     * @brief Attempts to pop a single value.
+     *
+     * @return popped value; empty if nothing is available (see `poll()`).
+     */
+    std::optional<value_t> try_pop() {
+      for(;;) {
+        std::size_t count = 1;
+        auto pos = claim(head_, 1, count);
+        if(!pos) return std::nullopt;
+        auto &cell = cells_[*pos & mask_];
+        std::optional<value_t> out;
+        if(cell.filled) out.emplace(std::move(*cell.slot.get()));
+        release(cell, *pos);
+        if(out) return out;
+      }
+    }
+
+    /**
+     * @brief Moves up to \p max values from consecutive slots claimed with a
+     * single CAS into \p out.
+     *
+     * @param[out] out output iterator accepting `Result<T, E>`.
+     * @param[in] max maximal number of values to pop.
+     * @return number of popped values; see `poll()` when it is `0`.
+     * @throw anything assigning to \p out throws; the rest of the claimed
+     * values is discarded then.
+     */
+    template<typename OutputIt>
+    std::size_t try_pop_n(OutputIt out, std::size_t max) {
+      if(max == 0) return 0;
+      for(;;) {
+        std::size_t count = max;
+        auto pos = claim(head_, 1, count);
+        if(!pos) return 0;
+        std::size_t popped = 0, i = 0;
+        try {
+          for(; i < count; ++i) {
+            auto &cell = cells_[(*pos + i) & mask_];
+            if(cell.filled) {
+              *out = std::move(*cell.slot.get());
+              ++out;
+              ++popped;
+            }
+            release(cell, *pos + i);
+          }
+        } catch(...) {
+          // Claimed slots cannot be handed back; free them for producers.
+          for(; i < count; ++i) release(cells_[(*pos + i) & mask_], *pos + i);
+          throw;
+        }
+        if(popped) return popped;
+      }
+    }
+
+    /**
+     * @brief Reports whether consumers should keep popping.
+     *
+     * @return `ChannelStatus::ok` if values are pending,
+     * `ChannelStatus::empty` if channel is open and empty,
+     * `ChannelStatus::closed`/`ChannelStatus::failed` once channel is closed
+     * and drained.
+     */
+    ChannelStatus poll() const noexcept {
+      auto status = this->drained_status();
+      if(tail_.value.load(std::memory_order_acquire)
+         != head_.value.load(std::memory_order_acquire))
+        return ChannelStatus::ok;
+      return status;
+    }
+
+   private:
+    /**
+     * @brief Claims up to \p count consecutive positions on \p index.
+     *
+     * A slot at position `p` is ready when its sequence equals `p + lag`
+     * (`lag` is `0` for producers and `1` for consumers).
+     *
+     * @param[in,out] count requested number of positions; set to the number
+     * actually claimed.
+     * @return first claimed position; empty if no slot is ready.
+     */
+    std::optional<std::size_t> claim(detail::ChannelIndex<Padded> &index,
+                                     std::size_t lag, std::size_t &count) {
+      auto pos = index.value.load(std::memory_order_relaxed);
+      for(;;) {
+        std::size_t ready = 0;
+        while(ready < count
+              && cells_[(pos + ready) & mask_].sequence.load(
+                     std::memory_order_acquire)
+                     == pos + ready + lag)
+          ++ready;
+        if(ready == 0) {
+          auto seq =
+              cells_[pos & mask_].sequence.load(std::memory_order_acquire);
+          if(static_cast<std::ptrdiff_t>(seq - (pos + lag)) < 0)
+            return std::nullopt;
+          pos = index.value.load(std::memory_order_relaxed);
+          continue;
+        }
+        if(index.value.compare_exchange_weak(pos, pos + ready,
+                                             std::memory_order_relaxed)) {
+          count = ready;
+          return pos;
+        }
+      }
+    }
+
+    /**
+     * @brief Constructs values of \p count claimed slots from \p pos on with
+     * \p make and publishes them.
+     *
+     * If \p make throws, the slot being built and the rest of the claim are
+     * published empty, so consumers skip them instead of waiting forever.
+     */
+    template<typename F>
+    void fill(std::size_t pos, std::size_t count, F &&make) {
+      std::size_t i = 0;
+      try {
+        for(; i < count; ++i) {
+          auto &cell = cells_[(pos + i) & mask_];
+          make(cell.slot.get());
+          cell.filled = true;
+          cell.sequence.store(pos + i + 1, std::memory_order_release);
+        }
+      } catch(...) {
+        for(; i < count; ++i) {
+          auto &cell = cells_[(pos + i) & mask_];
+          cell.filled = false;
+          cell.sequence.store(pos + i + 1, std::memory_order_release);
+        }
+        throw;
+      }
+    }
+
+    void release(Cell &cell, std::size_t pos) {
+      if(cell.filled) std::destroy_at(cell.slot.get());
+      cell.sequence.store(pos + mask_ + 1, std::memory_order_release);
+    }
+
+    std::unique_ptr<Cell[]> cells_;
+    detail::ChannelIndex<Padded> head_;
+    detail::ChannelIndex<Padded> tail_;
+  };
+}  // namespace sundry
@@ -0,0 +1,479 @@
+#pragma once
+
+#include "channel.hpp"
+#include "result.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <source_location>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Asynchronous logging of `Err` values.
+ *
+ * Logging thread copies the error payload, call site and timestamp into a
+ * ring owned by itself; a background thread formats the records and hands
+ * the text to a writer. Formatting, locking and I/O are thus kept off the
+ * thread that produced the error.
+ */
+namespace sundry {  // namespace sundry
+  /**
+   * @brief What `ErrorLog` does with a record which does not fit into the
+   * ring of the logging thread.
+   */
+  enum class Overflow : std::uint8_t {
+    drop,   ///< Record is counted in `ErrorLogStats::dropped` and discarded.
+    block,  ///< Logging thread waits for the background thread.
+  };
+
+  namespace detail {
+    /// Default clock of `ErrorLog`: `system_clock` in nanoseconds.
+    inline std::int64_t system_time() noexcept {
+      auto now = std::chrono::system_clock::now().time_since_epoch();
+      return std::chrono::nanoseconds(now).count();
+    }
+  }  // namespace detail
+
+  /// Largest `ErrorLogOptions::rate`: limiting works in whole nanoseconds.
+  inline constexpr std::uint32_t max_log_rate = 1'000'000'000;
+
+  /**
+   * @brief Configuration of `ErrorLog`.
+   */
+  struct ErrorLogOptions {
+    /// Records each logging thread can have in flight; a power of two.
+    std::size_t capacity = 1024;
+    Overflow overflow = Overflow::drop;  ///< Behaviour on full ring.
+    /// Records per second each logging thread may log, at most one per
+    /// nanosecond (`max_log_rate`); `0` for no limit.
+    std::uint32_t rate = 0;
+    /// Records a thread may log at once before `rate` applies; at least 1.
+    std::uint32_t burst = 16;
+    /// Sleep of the background thread when there is nothing to write.
+    std::chrono::microseconds idle = std::chrono::milliseconds(1);
+    /// Timestamp source, nanoseconds since `system_clock` epoch. Read for
+    /// every record and typically the largest part of its cost, so a coarse
+    /// clock (e.g. `CLOCK_REALTIME_COARSE`) makes logging much cheaper.
+    std::int64_t (*clock)() noexcept = &detail::system_time;
+  };
+
+  /**
+   * @brief Counters of `ErrorLog`, summed over logging threads.
+   */
+  struct ErrorLogStats {
+    std::uint64_t written = 0;  ///< Records handed to the writer.
+    std::uint64_t dropped = 0;  ///< Records lost to full or closed rings.
+    std::uint64_t limited = 0;  ///< Records rejected by the rate limit.
+    /// Logging threads whose rings are allocated; rings of exited threads
+    /// are freed once written.
+    std::size_t threads = 0;
+  };
+
+  namespace detail {
+    /// Payload bytes kept per record; longer strings are truncated.
+    inline constexpr std::size_t log_payload_size = 88;
+
+    /**
+     * @brief Single logged error: everything the background thread needs to
+     * print it, in a fixed-size, trivially copyable form.
+     */
+    struct LogRecord {
+      std::source_location site;
+      std::int64_t time;  ///< Nanoseconds since `system_clock` epoch.
+      /// Appends `Err(<payload>)` to the string.
+      void (*write)(std::string &, const LogRecord &);
+      std::uint32_t size;  ///< Used bytes of `payload`.
+      alignas(std::max_align_t) std::byte payload[log_payload_size];
+    };
+
+    /// Error values `ErrorLog` can copy into a `LogRecord`.
+    template<typename E>
+    concept LoggableError =
+        std::is_void_v<E>
+        || (Writable<E>
+            && (std::is_convertible_v<const E &, std::string_view>
+                || (std::is_trivially_copyable_v<E>
+                    && sizeof(E) <= log_payload_size
+                    && alignof(E) <= alignof(std::max_align_t))));
+
+    template<typename E>
+    inline constexpr bool log_as_text =
+        !std::is_void_v<E>
+        && std::is_convertible_v<const E &, std::string_view>;
+
+    /// Copies \p error into \p record; strings are truncated if needed.
+    template<LoggableError E>
+    void store_error(LogRecord &record, const Err<E> &error) noexcept {
+      if constexpr(std::is_void_v<E>)
+        record.size = 0;
+      else if constexpr(log_as_text<E>) {
+        std::string_view text = error.value;
+        record.size = std::min(text.size(), log_payload_size);
+        std::memcpy(record.payload, text.data(), record.size);
+      } else {
+        record.size = sizeof(E);
+        std::memcpy(record.payload, &error.value, sizeof(E));
+      }
+    }
+
+    /// Reverse of `store_error`, run on the background thread.
+    template<LoggableError E>
+    void write_error(std::string &out, const LogRecord &record) {
+      auto it = std::back_inserter(out);
+      if constexpr(std::is_void_v<E>)
+        format_to(it, Err<void> {});
+      else if constexpr(log_as_text<E>) {
+        auto text = reinterpret_cast<const char *>(record.payload);
+        format_to(it, Err<std::string_view> {{text, record.size}});
+      } else {
+        // `E` need not be default constructible: copy the bytes into an
+        // array first, `bit_cast` then makes a fresh `E` of them.
+        std::array<std::byte, sizeof(E)> bytes;
+        std::memcpy(bytes.data(), record.payload, sizeof(E));
+        format_to(it, Err<E> {std::bit_cast<E>(bytes)});
+      }
+    }
+
+    /// Formats \p record as `<seconds>.<nanoseconds> <file>:<line>
+    /// <function>: Err(<payload>)`, followed by a newline.
+    inline void write_record(std::string &out, const LogRecord &record) {
+      char digits[24];
+      auto seconds = record.time / 1'000'000'000;
+      auto fraction = record.time % 1'000'000'000;
+      auto end = std::to_chars(digits, digits + sizeof digits, seconds).ptr;
+      out.append(digits, end) += '.';
+      end = std::to_chars(digits, digits + sizeof digits, fraction).ptr;
+      out.append(9 - (end - digits), '0').append(digits, end) += ' ';
+      out.append(record.site.file_name()) += ':';
+      end = std::to_chars(digits, digits + sizeof digits,
+                          record.site.line()).ptr;
+      out.append(digits, end) += ' ';
+      out.append(record.site.function_name()) += ": ";
+      record.write(out, record);
+      out += '\n';
+    }
+  }  // namespace detail
+
+  /**
+   * @brief Sink writing `Err` values logged from any number of threads on a
+   * background thread.
+   *
+   * Every logging thread gets its own `SpscChannel` of fixed-size records,
+   * registered on its first `log` call; afterwards logging is a clock read,
+   * a copy of the payload and a push into that channel. When the thread
+   * exits, the background thread writes what is left in its ring and frees
+   * it; records logged by destructors of thread-local objects running after
+   * that are dropped. Records of a single thread are written in order;
+   * records of different threads are not ordered against each other, but
+   * carry timestamps.
+   *
+   * Payloads are copied as bytes, so only trivially copyable `Writable`
+   * errors and string-like errors (copied up to `detail::log_payload_size`
+   * characters) can be logged; print anything else into a string first.
+   *
+   * @code
+   * ErrorLog log([](std::string_view text) { std::fwrite(...); });
+   * parse::number<int>(field).log_if_err(log);
+   * @endcode
+   */
+  class ErrorLog {
+   public:
+    /// Receives formatted text, possibly several lines at once.
+    using Writer = std::function<void(std::string_view)>;
+
+    /**
+     * @brief Starts background thread handing formatted records to \p writer.
+     *
+     * @throw `std::invalid_argument` if `options.capacity` is not a power of
+     * two or `options.rate` exceeds `max_log_rate`.
+     */
+    explicit ErrorLog(Writer writer, ErrorLogOptions options = {})
+        : writer_(std::move(writer)), options_(options) {
+      if(options_.capacity == 0
+         || (options_.capacity & (options_.capacity - 1)) != 0)
+        throw std::invalid_argument(
+            "error log capacity must be a non-zero power of two");
+      if(options_.rate > max_log_rate)
+        throw std::invalid_argument(
+            "error log rate must not exceed one record per nanosecond");
+      if(options_.rate)
+        interval_ = 1'000'000'000 / options_.rate;
+      options_.burst = std::max(options_.burst, std::uint32_t {1});
+      thread_ = std::thread([this] { run(); });
+    }
+
+    ErrorLog(const ErrorLog &) = delete;
+    ErrorLog &operator=(const ErrorLog &) = delete;
+
+    /**
+     * @brief Writes all records logged so far and stops background thread.
+     */
+    ~ErrorLog() { stop(); }
+
+    /**
+     * @brief Queues \p error logged at \p site for writing.
+     *
+     * @return `true` if record was queued; `false` if it was dropped or rate
+     * limited (see `stats()`).
+     */
+    template<detail::LoggableError E>
+    bool log(const Err<E> &error,
+             std::source_location site = std::source_location::current()) {
+      auto time = options_.clock();
+      auto ring_ptr = producer();
+      if(!ring_ptr) {
+        dropped_.fetch_add(1, std::memory_order_relaxed);
+        return false;
+      }
+      auto &ring = *ring_ptr;
+      if(interval_ && !ring.admit(time, interval_, options_.burst)) {
+        ring.limited.fetch_add(1, std::memory_order_relaxed);
+        return false;
+      }
+      Ok<detail::LogRecord> record;
+      record.value.site = site;
+      record.value.time = time;
+      record.value.write = &detail::write_error<E>;
+      detail::store_error(record.value, error);
+      auto status = ring.channel.try_push(record);
+      if(status == ChannelStatus::full
+         && options_.overflow == Overflow::block) {
+        // Background thread may be idle; waiting out `options_.idle` would
+        // cap throughput at one ring per idle period.
+        backlog_.store(true, std::memory_order_relaxed);
+        wake_.notify_one();
+        status = ring.channel.push(record);
+      }
+      if(status == ChannelStatus::ok) return true;
+      ring.dropped.fetch_add(1, std::memory_order_relaxed);
+      return false;
+    }
+
+    /**
+     * @brief Waits until records logged before the call are written.
+     */
+    void flush() {
+      std::unique_lock lock(mutex_);
+      auto target = ++flush_requested_;
+      wake_.notify_all();
+      flushed_.wait(lock, [&] { return flush_done_ >= target || stopped_; });
+    }
+
+    /**
+     * @brief Writes remaining records and stops background thread. Records
+     * logged afterwards (or concurrently) are dropped. Called by destructor.
+     */
+    void stop() {
+      {
+        std::lock_guard lock(mutex_);
+        if(stopped_) return;
+        stopped_ = true;
+        for(auto &ring : rings_) ring->channel.close();
+      }
+      wake_.notify_all();
+      thread_.join();
+      flushed_.notify_all();
+    }
+
+    /**
+     * @brief Returns counters summed over logging threads.
+     */
+    ErrorLogStats stats() const {
+      ErrorLogStats out;
+      std::lock_guard lock(mutex_);
+      out.written = written_.load(std::memory_order_relaxed);
+      out.dropped = dropped_.load(std::memory_order_relaxed) + retired_dropped_;
+      out.limited = retired_limited_;
+      out.threads = rings_.size();
+      for(auto &ring : rings_) {
+        out.dropped += ring->dropped.load(std::memory_order_relaxed);
+        out.limited += ring->limited.load(std::memory_order_relaxed);
+      }
+      return out;
+    }
+
+   private:
+    /// Ring of a single logging thread plus its counters.
+    struct Producer {
+      explicit Producer(std::size_t capacity) : channel(capacity) {}
+
+      /// Generic cell rate algorithm: a record is admitted unless it comes
+      /// more than `burst - 1` intervals ahead of schedule.
+      bool admit(std::int64_t now, std::int64_t interval,
+                 std::uint32_t burst) noexcept {
+        auto due = std::max(schedule, now);
+        if(due - now > interval * static_cast<std::int64_t>(burst - 1))
+          return false;
+        schedule = due + interval;
+        return true;
+      }
+
+      SpscChannel<detail::LogRecord, void> channel;
+      std::atomic<std::uint64_t> dropped {0};
+      std::atomic<std::uint64_t> limited {0};
+      /// Set when the logging thread exits; it pushes nothing afterwards.
+      std::atomic<bool> retired {false};
+      std::int64_t schedule = 0;  ///< Owned by logging thread.
+    };
+
+    /// Rings of the calling thread, retired when the thread exits. Shared
+    /// with `rings_`, so whichever of thread and log goes last frees them.
+    struct ThreadRings {
+      struct Entry {
+        std::uint64_t log;
+        std::shared_ptr<Producer> ring;
+      };
+
+      ~ThreadRings() {
+        for(auto &entry : entries)
+          entry.ring->retired.store(true, std::memory_order_release);
+        exited = true;
+      }
+
+      /// Trivially destructible, so still readable after `~ThreadRings`.
+      static inline thread_local bool exited = false;
+
+      // Keyed by id rather than address, so a new log reusing the address
+      // of a destroyed one never finds its rings.
+      std::vector<Entry> entries;
+      std::uint64_t last_log = 0;
+      Producer *last = nullptr;
+    };
+
+    /// Returns ring of calling thread, registering it on first use;
+    /// `nullptr` once the thread has retired its rings on exit.
+    Producer *producer() {
+      if(ThreadRings::exited) return nullptr;
+      thread_local ThreadRings local;
+      if(local.last_log == id_) return local.last;
+      auto &entries = local.entries;
+      auto found = std::find_if(entries.begin(), entries.end(),
+                                [&](const auto &e) { return e.log == id_; });
+      if(found == entries.end()) {
+        // Stopped logs take no more records; let go of their rings, as a
+        // long-lived thread may outlive many logs.
+        std::erase_if(entries, [](const auto &e) {
+          return e.ring->channel.is_closed();
+        });
+        auto ring = std::make_shared<Producer>(options_.capacity);
+        {
+          std::lock_guard lock(mutex_);
+          if(stopped_) ring->channel.close();
+          rings_.push_back(ring);
+        }
+        found = entries.insert(entries.end(), {id_, std::move(ring)});
+      }
+      local.last_log = id_;
+      local.last = found->ring.get();
+      return local.last;
+    }
+
+    /// Drains all rings once; returns number of written records.
+    std::size_t drain(std::vector<Producer *> &rings,
+                      std::vector<Result<detail::LogRecord, void>> &batch) {
+      {
+        std::lock_guard lock(mutex_);
+        rings.clear();
+        for(auto &ring : rings_) rings.push_back(ring.get());
+      }
+      std::size_t count = 0;
+      std::vector<Producer *> retired;
+      for(auto ring : rings) {
+        // Read before draining: afterwards, a retired ring stays empty.
+        if(ring->retired.load(std::memory_order_acquire))
+          retired.push_back(ring);
+        for(;;) {
+          batch.clear();
+          auto popped = ring->channel.try_pop_n(std::back_inserter(batch),
+                                                options_.capacity);
+          if(!popped) break;
+          text_.clear();
+          for(auto &record : batch)
+            detail::write_record(text_, record.ok_value_.value);
+          writer_(text_);
+          count += popped;
+        }
+      }
+      written_.fetch_add(count, std::memory_order_relaxed);
+      if(!retired.empty()) {
+        std::lock_guard lock(mutex_);
+        std::erase_if(rings_, [&](const auto &ring) {
+          if(std::find(retired.begin(), retired.end(), ring.get())
+             == retired.end())
+            return false;
+          retired_dropped_ += ring->dropped.load(std::memory_order_relaxed);
+          retired_limited_ += ring->limited.load(std::memory_order_relaxed);
+          return true;
+        });
+      }
+      return count;
+    }
+
+    void run() {
+      std::vector<Producer *> rings;
+      std::vector<Result<detail::LogRecord, void>> batch;
+      batch.reserve(options_.capacity);
+      for(;;) {
+        std::uint64_t target;
+        bool stopping;
+        {
+          std::lock_guard lock(mutex_);
+          target = flush_requested_;
+          stopping = stopped_;
+        }
+        auto count = drain(rings, batch);
+        std::unique_lock lock(mutex_);
+        flush_done_ = target;
+        flushed_.notify_all();
+        if(stopping) return;
+        if(!count)
+          wake_.wait_for(lock, options_.idle, [&] {
+            return stopped_ || flush_requested_ != flush_done_
+                   || backlog_.exchange(false, std::memory_order_relaxed);
+          });
+      }
+    }
+
+    static std::uint64_t next_id() noexcept {
+      static std::atomic<std::uint64_t> ids {0};
+      return ids.fetch_add(1, std::memory_order_relaxed) + 1;
+    }
+
+    const std::uint64_t id_ = next_id();
+    Writer writer_;
+    ErrorLogOptions options_;
+    /// Nanoseconds between records at `rate`, at least 1; `0` if unlimited.
+    std::int64_t interval_ = 0;
+    std::string text_;           ///< Owned by background thread.
+    std::atomic<std::uint64_t> written_ {0};
+    std::atomic<bool> backlog_ {false};  ///< Some ring is full.
+    /// Records logged by threads which had retired their rings.
+    std::atomic<std::uint64_t> dropped_ {0};
+
+    mutable std::mutex mutex_;  ///< Guards everything below.
+    std::vector<std::shared_ptr<Producer>> rings_;
+    /// Counters of freed rings.
+    std::uint64_t retired_dropped_ = 0, retired_limited_ = 0;
+    std::condition_variable wake_, flushed_;
+    std::uint64_t flush_requested_ = 0, flush_done_ = 0;
+    bool stopped_ = false;
+    std::thread thread_;
+  };
+}  // namespace sundry
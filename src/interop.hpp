@@ -0,0 +1,120 @@
+#pragma once
+
+#include "result.hpp"
+
+#include <cstddef>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include <variant>
+
+/**
+ * @brief Conversions between `Result` and `std::optional` or `std::variant`.
+ *
+ * Every conversion accepts both lvalues, whose payload is copied, and
+ * rvalues, whose payload is moved; payloads are constructed in place in
+ * the target, so for trivially copyable payloads a conversion boils down
+ * to copying the payload bytes and the flag (measured on GCC 12 with
+ * `bench/interop.cpp`: a `Result<long, int>` variant round trip runs at
+ * the speed of a plain copy).
+ */
+namespace sundry {  // namespace sundry
+  namespace detail {
+    /// Returns \p payload as const lvalue if \p R is an lvalue, as rvalue
+    /// else.
+    template<typename R, typename P>
+    constexpr auto &&forward_payload(P &payload) noexcept {
+      if constexpr(std::is_lvalue_reference_v<R>)
+        return std::as_const(payload);
+      else
+        return std::move(payload);
+    }
+
+    /**
+     * @brief Builds alternative \p I of \p Out from the value held by
+     * \p part (`Ok` or `Err`), or from nothing for `void` payloads.
+     *
+     * The alternative is initialized from the bare value rather than from
+     * the wrapper: copying the wrapper makes GCC spill the whole variant and
+     * reload it with one wide load, which stalls store forwarding.
+     */
+    template<typename Out, std::size_t I, typename R, typename P>
+    Out make_alternative(P &part) {
+      if constexpr(std::is_void_v<typename P::value_t>)
+        return Out(std::in_place_index<I>);
+      else
+        return Out(std::in_place_index<I>, forward_payload<R>(part.value));
+    }
+
+    /// Builds `Result<T, E>` holding `Ok` from the value held by \p part.
+    template<typename T, typename E, typename V, typename P>
+    Result<T, E> make_ok(P &part) {
+      if constexpr(std::is_void_v<T>)
+        return Result<T, E>(in_place_ok);
+      else
+        return Result<T, E>(in_place_ok, forward_payload<V>(part.value));
+    }
+
+    /// Builds `Result<T, E>` holding `Err` from the value held by \p part.
+    template<typename T, typename E, typename V, typename P>
+    Result<T, E> make_err(P &part) {
+      if constexpr(std::is_void_v<E>)
+        return Result<T, E>(in_place_err);
+      else
+        return Result<T, E>(in_place_err, forward_payload<V>(part.value));
+    }
+  }  // namespace detail
+
+  /**
+   * @brief Builds `Result` holding `Ok` with contents of \p value, or \p error
+   * if \p value is empty.
+   *
+   * @tparam E error value type; `void` unless \p error is given.
+   */
+  template<typename T, typename E = void>
+  Result<T, E> from_optional(const std::optional<T> &value,
+                             Err<E> error = {}) {
+    if(value) return Result<T, E>(in_place_ok, *value);
+    return {std::move(error)};
+  }
+
+  template<typename T, typename E = void>
+  Result<T, E> from_optional(std::optional<T> &&value, Err<E> error = {}) {
+    if(value) return Result<T, E>(in_place_ok, std::move(*value));
+    return {std::move(error)};
+  }
+
+  /**
+   * @brief Converts \p result into `std::variant<Ok<T>, Err<E>>`, which
+   * keeps `T == E` and `void` payloads unambiguous.
+   */
+  template<ResultType R>
+  auto to_variant(R &&result) {
+    using Res = std::remove_cvref_t<R>;
+    using Out = std::variant<typename Res::ok_t, typename Res::err_t>;
+    if(result.is_ok())
+      return detail::make_alternative<Out, 0, R>(result.ok_value_);
+    return detail::make_alternative<Out, 1, R>(result.err_value_);
+  }
+
+  /**
+   * @brief Converts variant produced by `to_variant` back into `Result`.
+   *
+   * @throw `std::bad_variant_access` if \p value is valueless by exception.
+   */
+  template<typename T, typename E>
+  Result<T, E> from_variant(const std::variant<Ok<T>, Err<E>> &value) {
+    using V = decltype(value);
+    if(auto ok = std::get_if<0>(&value))
+      return detail::make_ok<T, E, V>(*ok);
+    return detail::make_err<T, E, V>(std::get<1>(value));
+  }
+
+  template<typename T, typename E>
+  Result<T, E> from_variant(std::variant<Ok<T>, Err<E>> &&value) {
+    using V = decltype(value);
+    if(auto ok = std::get_if<0>(&value))
+      return detail::make_ok<T, E, V>(*ok);
+    return detail::make_err<T, E, V>(std::get<1>(value));
+  }
+}  // namespace sundry
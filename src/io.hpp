@@ -0,0 +1,291 @@
+#pragma once
+
+#include "result.hpp"
+
+#include <cerrno>
+#include <cstddef>
+#include <ostream>
+#include <span>
+#include <system_error>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+namespace sundry::io {  // namespace sundry::io
+  /**
+   * @brief Compact error holding `errno` of a failed system call.
+   */
+  struct Errno {
+    int code;  ///< Value of `errno`.
+
+    /**
+     * @brief Captures current `errno`.
+     */
+    static Errno last() noexcept { return {errno}; }
+
+    bool operator==(const Errno &) const = default;
+  };
+
+  /**
+   * @brief Prints description of \p error; makes `Errno` `Printable`.
+   */
+  inline std::ostream &operator<<(std::ostream &os, const Errno &error) {
+    return os << std::generic_category().message(error.code) << " (errno "
+              << error.code << ')';
+  }
+
+  /**
+   * @brief Owning wrapper around a file descriptor.
+   */
+  class File {
+   public:
+    File() noexcept = default;
+
+    /**
+     * @brief Takes ownership of \p fd.
+     */
+    explicit File(int fd) noexcept : fd_(fd) {}
+
+    File(File &&other) noexcept : fd_(std::exchange(other.fd_, -1)) {}
+
+    File &operator=(File &&other) noexcept {
+      if(this != &other) {
+        reset();
+        fd_ = std::exchange(other.fd_, -1);
+      }
+      return *this;
+    }
+
+    ~File() { reset(); }
+
+    /**
+     * @brief Returns underlying descriptor; `-1` if none.
+     */
+    int fd() const noexcept { return fd_; }
+
+    bool is_open() const noexcept { return fd_ >= 0; }
+
+    /**
+     * @brief Gives up ownership of the descriptor.
+     */
+    int release() noexcept { return std::exchange(fd_, -1); }
+
+    /**
+     * @brief Closes descriptor, reporting failure of `close(2)`.
+     */
+    Result<void, Errno> close() noexcept {
+      if(::close(release()) != 0) return {Err<Errno> {Errno::last()}};
+      return {Ok<void> {}};
+    }
+
+   private:
+    void reset() noexcept {
+      if(fd_ >= 0) ::close(fd_);
+      fd_ = -1;
+    }
+
+    int fd_ = -1;
+  };
+
+  /**
+   * @brief Opens file with `open(2)`.
+   *
+   * @param[in] flags `O_*` flags; `O_CLOEXEC` is always added.
+   * @param[in] mode permissions of a created file.
+   */
+  inline Result<File, Errno> open(const char *path, int flags = O_RDONLY,
+                                  mode_t mode = 0644) noexcept {
+    int fd;
+    do
+      fd = ::open(path, flags | O_CLOEXEC, mode);
+    while(fd < 0 && errno == EINTR);
+    if(fd < 0) return {Err<Errno> {Errno::last()}};
+    return Result<File, Errno>(in_place_ok, fd);
+  }
+
+  namespace detail {
+    /// Repeats \p call while it fails with `EINTR`.
+    template<typename F>
+    Result<std::size_t, Errno> retry(F call) noexcept {
+      ssize_t n;
+      do
+        n = call();
+      while(n < 0 && errno == EINTR);
+      if(n < 0) return {Err<Errno> {Errno::last()}};
+      return {Ok<std::size_t> {static_cast<std::size_t>(n)}};
+    }
+
+    inline Result<std::span<std::byte>, Errno>
+    filled(Result<std::size_t, Errno> &&n, std::span<std::byte> buffer) {
+      if(n.is_err()) return {n.err_value_};
+      return {Ok<std::span<std::byte>> {buffer.first(n.ok_value_.value)}};
+    }
+  }  // namespace detail
+
+  /**
+   * @brief Reads into \p buffer with a single `read(2)`.
+   *
+   * @return filled prefix of \p buffer; empty at end of file.
+   */
+  inline Result<std::span<std::byte>, Errno>
+  read(const File &file, std::span<std::byte> buffer) noexcept {
+    return detail::filled(detail::retry([&] {
+                            return ::read(file.fd(), buffer.data(),
+                                          buffer.size());
+                          }),
+                          buffer);
+  }
+
+  /**
+   * @brief Reads into \p buffer from \p offset with a single `pread(2)`.
+   *
+   * @return filled prefix of \p buffer; empty at end of file.
+   */
+  inline Result<std::span<std::byte>, Errno>
+  pread(const File &file, std::span<std::byte> buffer, off_t offset) noexcept {
+    return detail::filled(detail::retry([&] {
+                            return ::pread(file.fd(), buffer.data(),
+                                           buffer.size(), offset);
+                          }),
+                          buffer);
+  }
+
+  /**
+   * @brief Writes \p data with a single `write(2)`.
+   *
+   * @return number of bytes written, which may be less than `data.size()`.
+   */
+  inline Result<std::size_t, Errno>
+  write(const File &file, std::span<const std::byte> data) noexcept {
+    return detail::retry(
+        [&] { return ::write(file.fd(), data.data(), data.size()); });
+  }
+
+  /**
+   * @brief Writes \p data at \p offset with a single `pwrite(2)`.
+   *
+   * @return number of bytes written, which may be less than `data.size()`.
+   */
+  inline Result<std::size_t, Errno> pwrite(const File &file,
+                                           std::span<const std::byte> data,
+                                           off_t offset) noexcept {
+    return detail::retry(
+        [&] { return ::pwrite(file.fd(), data.data(), data.size(), offset); });
+  }
+
+  /**
+   * @brief Describes \p bytes as an element of a vectored I/O request.
+   */
+  inline iovec buffer(std::span<std::byte> bytes) noexcept {
+    return {bytes.data(), bytes.size()};
+  }
+
+  /**
+   * @brief Scatters a single `readv(2)` into \p buffers, in order.
+   *
+   * @param[in] buffers at most `IOV_MAX` buffers, see `buffer()`.
+   * @return total number of bytes read.
+   */
+  inline Result<std::size_t, Errno>
+  readv(const File &file, std::span<const iovec> buffers) noexcept {
+    return detail::retry([&] {
+      return ::readv(file.fd(), buffers.data(),
+                     static_cast<int>(buffers.size()));
+    });
+  }
+
+  /**
+   * @brief Scatters a single `preadv(2)` from \p offset into \p buffers, in
+   * order.
+   *
+   * @param[in] buffers at most `IOV_MAX` buffers, see `buffer()`.
+   * @return total number of bytes read.
+   */
+  inline Result<std::size_t, Errno> preadv(const File &file,
+                                           std::span<const iovec> buffers,
+                                           off_t offset) noexcept {
+    return detail::retry([&] {
+      return ::preadv(file.fd(), buffers.data(),
+                      static_cast<int>(buffers.size()), offset);
+    });
+  }
+
+  /**
+   * @brief Read-only memory mapping of a whole file.
+   */
+  class MappedFile {
+   public:
+    MappedFile() noexcept = default;
+
+    MappedFile(MappedFile &&other) noexcept
+        : data_(std::exchange(other.data_, nullptr)),
+          size_(std::exchange(other.size_, 0)) {}
+
+    MappedFile &operator=(MappedFile &&other) noexcept {
+      if(this != &other) {
+        reset();
+        data_ = std::exchange(other.data_, nullptr);
+        size_ = std::exchange(other.size_, 0);
+      }
+      return *this;
+    }
+
+    ~MappedFile() { reset(); }
+
+    /**
+     * @brief Maps contents of an open \p file. The mapping stays valid after
+     * \p file is closed.
+     */
+    static Result<MappedFile, Errno> map(const File &file) noexcept {
+      struct stat info;
+      if(::fstat(file.fd(), &info) != 0) return {Err<Errno> {Errno::last()}};
+      MappedFile mapped;
+      if(info.st_size == 0) return {Ok<MappedFile> {std::move(mapped)}};
+      auto size = static_cast<std::size_t>(info.st_size);
+      auto data = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, file.fd(), 0);
+      if(data == MAP_FAILED) return {Err<Errno> {Errno::last()}};
+      mapped.data_ = static_cast<const std::byte *>(data);
+      mapped.size_ = size;
+      return {Ok<MappedFile> {std::move(mapped)}};
+    }
+
+    /**
+     * @brief Opens and maps file at \p path.
+     */
+    static Result<MappedFile, Errno> open(const char *path) noexcept {
+      auto file = io::open(path);
+      if(file.is_err()) return {file.err_value_};
+      return map(file.ok_value_.value);
+    }
+
+    /**
+     * @brief Mapped contents; empty for an empty file.
+     */
+    std::span<const std::byte> bytes() const noexcept { return {data_, size_}; }
+
+    std::size_t size() const noexcept { return size_; }
+
+    /**
+     * @brief Passes access pattern \p advice (`MADV_*`) to the kernel.
+     */
+    Result<void, Errno> advise(int advice) const noexcept {
+      if(size_ && ::madvise(const_cast<std::byte *>(data_), size_, advice))
+        return {Err<Errno> {Errno::last()}};
+      return {Ok<void> {}};
+    }
+
+   private:
+    void reset() noexcept {
+      if(data_) ::munmap(const_cast<std::byte *>(data_), size_);
+      data_ = nullptr;
+      size_ = 0;
+    }
+
+    const std::byte *data_ = nullptr;
+    std::size_t size_ = 0;
+  };
+}  // namespace sundry::io
@@ -0,0 +1,344 @@
+#pragma once
+
+#include "result.hpp"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <charconv>
+#include <chrono>
+#include <concepts>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <ostream>
+#include <string_view>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace sundry::parse {  // namespace sundry::parse
+  /**
+   * @brief Reason of a parse failure.
+   */
+  enum class ParseErrc : std::uint8_t {
+    empty,         ///< Input is empty.
+    invalid,       ///< Input does not hold a value of requested type.
+    out_of_range,  ///< Value does not fit into requested type.
+    trailing,      ///< Value is followed by unexpected characters.
+  };
+
+  /**
+   * @brief Compact parse error: reason and offset of the offending character.
+   */
+  struct ParseError {
+    ParseErrc code;          ///< Reason of failure.
+    std::uint32_t position;  ///< Offset from the beginning of parsed text.
+
+    bool operator==(const ParseError &) const = default;
+  };
+
+  /**
+   * @brief Prints \p error as e.g. `invalid at 3`; makes `ParseError`
+   * `Printable`.
+   */
+  inline std::ostream &operator<<(std::ostream &os, const ParseError &error) {
+    constexpr const char *names[] = {"empty", "invalid", "out of range",
+                                     "trailing characters"};
+    return os << names[static_cast<int>(error.code)] << " at "
+              << error.position;
+  }
+
+  /**
+   * @brief Numbers accepted by `number`.
+   */
+  template<typename T>
+  concept Number = (std::integral<T> || std::floating_point<T>)
+                   && !std::same_as<T, bool>;
+
+  namespace detail {
+    inline Err<ParseError> fail(ParseErrc code, std::size_t pos) {
+      return {{code, static_cast<std::uint32_t>(pos)}};
+    }
+
+    /// Checks if 8 bytes starting at \p p are all ASCII digits.
+    inline bool all_digits8(const char *p) noexcept {
+      std::uint64_t v;
+      std::memcpy(&v, p, sizeof v);
+      return ((v & 0xF0F0F0F0F0F0F0F0)
+              | (((v + 0x0606060606060606) & 0xF0F0F0F0F0F0F0F0) >> 4))
+             == 0x3333333333333333;
+    }
+
+    /// Converts 8 ASCII digits starting at \p p with three multiplications.
+    inline std::uint32_t parse_digits8(const char *p) noexcept {
+      std::uint64_t v;
+      std::memcpy(&v, p, sizeof v);
+      if constexpr(std::endian::native == std::endian::big)
+        v = __builtin_bswap64(v);
+      v = (v & 0x0F0F0F0F0F0F0F0F) * 2561 >> 8;
+      v = (v & 0x00FF00FF00FF00FF) * 6553601 >> 16;
+      return static_cast<std::uint32_t>((v & 0x0000FFFF0000FFFF)
+                                            * 42949672960001
+                                        >> 32);
+    }
+
+    /**
+     * @brief Counts ASCII digits at the beginning of [\p first, \p limit).
+     *
+     * Uses 16-byte SSE2 compares (8-byte SWAR checks without SSE2) while
+     * enough input is left; bytes past \p limit are never read.
+     */
+    inline std::size_t digit_run(const char *first,
+                                 const char *limit) noexcept {
+      auto p = first;
+#if defined(__SSE2__)
+      // c - ('0' + 128) maps digits to [-128, -119], everything else above.
+      const auto bias = _mm_set1_epi8(static_cast<char>('0' + 128));
+      const auto bound = _mm_set1_epi8(-128 + 10);
+      while(limit - p >= 16) {
+        auto chunk = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p));
+        auto digits = _mm_cmplt_epi8(_mm_sub_epi8(chunk, bias), bound);
+        auto mask = static_cast<unsigned>(_mm_movemask_epi8(digits));
+        if(mask != 0xFFFF)
+          return static_cast<std::size_t>(p - first) + std::countr_one(mask);
+        p += 16;
+      }
+#endif
+      while(limit - p >= 8 && all_digits8(p)) p += 8;
+      while(p != limit && static_cast<unsigned char>(*p - '0') < 10) ++p;
+      return static_cast<std::size_t>(p - first);
+    }
+
+    /**
+     * @brief Parses integer occupying exactly [\p first, \p last), given
+     * that \p run digits start at \p digits (after optional sign).
+     */
+    template<std::integral T>
+    Result<T, ParseError> integer(const char *first, const char *last,
+                                  const char *digits, std::size_t run) {
+      if(first == last) return fail(ParseErrc::empty, 0);
+      auto p = digits;
+      bool negative = p != first;
+      auto field = static_cast<std::size_t>(last - p);
+      if(run > field) run = field;
+      if(run == 0) return fail(ParseErrc::invalid, p - first);
+      if(run != field) return fail(ParseErrc::trailing, p - first + run);
+      // Values with at most `digits10` digits cannot overflow `T`, nor the
+      // 64-bit accumulator if capped (`__int128` has 38): fast path.
+      constexpr std::size_t fast_digits =
+          std::min(std::numeric_limits<T>::digits10,
+                   std::numeric_limits<std::uint64_t>::digits10);
+      if(run <= fast_digits) {
+        std::uint64_t value = 0;
+        for(; run >= 8; run -= 8, p += 8)
+          value = value * 100000000 + parse_digits8(p);
+        for(; run; --run, ++p) value = value * 10 + (*p - '0');
+        // Negate in `T`: negating the accumulator would wrap it modulo
+        // 2^64, which is only right for types of at most 64 bits.
+        if(negative) return {Ok<T> {static_cast<T>(-static_cast<T>(value))}};
+        return {Ok<T> {static_cast<T>(value)}};
+      }
+      T value {};
+      auto [end, ec] = std::from_chars(first, last, value);
+      if(ec == std::errc::result_out_of_range)
+        return fail(ParseErrc::out_of_range, 0);
+      if(ec != std::errc {}) return fail(ParseErrc::invalid, 0);
+      return {Ok<T> {value}};
+    }
+
+    /**
+     * @brief Parses integer occupying exactly [\p first, \p last).
+     *
+     * @param[in] limit end of readable memory, `limit >= last`; lets digit
+     * scan use wide loads past the end of the field.
+     */
+    template<std::integral T>
+    Result<T, ParseError> integer(const char *first, const char *last,
+                                  const char *limit) {
+      auto digits = first;
+      if constexpr(std::is_signed_v<T>)
+        digits += first != last && *first == '-';
+      return integer<T>(first, last, digits, digit_run(digits, limit));
+    }
+
+    template<std::floating_point T>
+    Result<T, ParseError> floating(const char *first, const char *last) {
+      if(first == last) return fail(ParseErrc::empty, 0);
+      T value;
+      auto [end, ec] = std::from_chars(first, last, value);
+      if(ec == std::errc::invalid_argument)
+        return fail(ParseErrc::invalid, 0);
+      if(ec == std::errc::result_out_of_range)
+        return fail(ParseErrc::out_of_range, 0);
+      if(end != last) return fail(ParseErrc::trailing, end - first);
+      return {Ok<T> {value}};
+    }
+
+    template<Number T>
+    Result<T, ParseError> number(const char *first, const char *last,
+                                 const char *limit) {
+      if constexpr(std::integral<T>)
+        return integer<T>(first, last, limit);
+      else
+        return floating<T>(first, last);
+    }
+  }  // namespace detail
+
+  /**
+   * @brief Parses decimal number occupying the whole \p text.
+   *
+   * Integers are optionally prefixed with `-`; floating point values follow
+   * `std::from_chars` general format.
+   *
+   * @tparam T integral or floating point type.
+   * @return parsed value or `ParseError` with offset into \p text.
+   */
+  template<Number T>
+  Result<T, ParseError> number(std::string_view text) {
+    auto last = text.data() + text.size();
+    return detail::number<T>(text.data(), last, last);
+  }
+
+  /**
+   * @brief Parses `true`, `false`, `1` or `0`.
+   */
+  inline Result<bool, ParseError> boolean(std::string_view text) {
+    if(text.empty()) return detail::fail(ParseErrc::empty, 0);
+    if(text == "true" || text == "1") return {Ok<bool> {true}};
+    if(text == "false" || text == "0") return {Ok<bool> {false}};
+    return detail::fail(ParseErrc::invalid, 0);
+  }
+
+  /**
+   * @brief Parses duration written as a sequence of `<integer><unit>` pairs,
+   * e.g. `250ms` or `1h30m`. Units are `ns`, `us`, `ms`, `s`, `m` and `h`.
+   */
+  inline Result<std::chrono::nanoseconds, ParseError>
+  duration(std::string_view text) {
+    using Rep = std::chrono::nanoseconds::rep;
+    constexpr std::pair<std::string_view, Rep> units[] = {
+        {"ns", 1},           {"us", 1'000},          {"ms", 1'000'000},
+        {"s", 1'000'000'000}, {"m", 60'000'000'000}, {"h", 3'600'000'000'000}};
+    if(text.empty()) return detail::fail(ParseErrc::empty, 0);
+    auto first = text.data(), last = first + text.size(), p = first;
+    Rep total = 0;
+    while(p != last) {
+      Rep count;
+      auto [end, ec] = std::from_chars(p, last, count);
+      if(ec == std::errc::invalid_argument || count < 0)
+        return detail::fail(ParseErrc::invalid, p - first);
+      if(ec == std::errc::result_out_of_range)
+        return detail::fail(ParseErrc::out_of_range, p - first);
+      auto unit_end = end;
+      while(unit_end != last && (*unit_end < '0' || *unit_end > '9'))
+        ++unit_end;
+      std::string_view unit(end, unit_end - end);
+      Rep factor = 0;
+      for(auto &[name, scale] : units)
+        if(unit == name) factor = scale;
+      if(factor == 0) return detail::fail(ParseErrc::invalid, end - first);
+      Rep scaled;
+      if(__builtin_mul_overflow(count, factor, &scaled)
+         || __builtin_add_overflow(total, scaled, &total))
+        return detail::fail(ParseErrc::out_of_range, p - first);
+      p = unit_end;
+    }
+    return {Ok<std::chrono::nanoseconds> {std::chrono::nanoseconds(total)}};
+  }
+
+  /**
+   * @brief Looks \p text up in a table of enumerator names.
+   *
+   * @param[in] names pairs of name and enumerator.
+   */
+  template<typename Enum, std::size_t N>
+  Result<Enum, ParseError>
+  enumeration(std::string_view text,
+              const std::array<std::pair<std::string_view, Enum>, N> &names) {
+    if(text.empty()) return detail::fail(ParseErrc::empty, 0);
+    for(auto &[name, value] : names)
+      if(name == text) return {Ok<Enum> {value}};
+    return detail::fail(ParseErrc::invalid, 0);
+  }
+
+  /**
+   * @brief Columnar output of batch parsing.
+   *
+   * @tparam T parsed type.
+   */
+  template<typename T>
+  struct Column {
+    std::vector<T> values;  ///< One per field; value-initialized if failed.
+    std::vector<std::size_t> failed;  ///< Indices of fields failed to parse.
+    std::vector<ParseError> errors;   ///< Errors matching `failed`; offsets
+                                      ///< are relative to the field.
+
+    /**
+     * @brief Drops contents, keeping allocated memory.
+     */
+    void clear() noexcept {
+      values.clear();
+      failed.clear();
+      errors.clear();
+    }
+  };
+
+  /**
+   * @brief Parses numbers separated by \p delimiter into \p out. A trailing
+   * delimiter is allowed; empty fields in between fail with
+   * `ParseErrc::empty`.
+   *
+   * Fields are parsed in place and digit scans may read ahead up to the end
+   * of \p buffer, so runs are validated 16 bytes at a time.
+   *
+   * @param[out] out column to fill; previous contents are dropped.
+   */
+  template<Number T>
+  void column(std::string_view buffer, char delimiter, Column<T> &out) {
+    out.clear();
+    auto p = buffer.data(), limit = p + buffer.size();
+    while(p != limit) {
+      auto digits = p, next = p;
+      std::size_t run = 0;
+      if constexpr(std::integral<T>) {
+        // Digit scan usually ends right at the delimiter; no search needed.
+        if constexpr(std::is_signed_v<T>) digits += *p == '-';
+        run = detail::digit_run(digits, limit);
+        next = digits + run;
+      }
+      if(next != limit && *next != delimiter)
+        next = static_cast<const char *>(std::memchr(
+            next, delimiter, static_cast<std::size_t>(limit - next)));
+      auto last = next ? next : limit;
+      auto parsed = [&] {
+        if constexpr(std::integral<T>)
+          return detail::integer<T>(p, last, digits, run);
+        else
+          return detail::floating<T>(p, last);
+      }();
+      if(parsed.is_ok())
+        out.values.push_back(parsed.ok_value_.value);
+      else {
+        out.failed.push_back(out.values.size());
+        out.errors.push_back(parsed.err_value_.value);
+        out.values.emplace_back();
+      }
+      p = last == limit ? limit : last + 1;
+    }
+  }
+
+  /**
+   * @brief Parses numbers separated by \p delimiter into a new column.
+   */
+  template<Number T>
+  Column<T> column(std::string_view buffer, char delimiter) {
+    Column<T> out;
+    column(buffer, delimiter, out);
+    return out;
+  }
+}  // namespace sundry::parse
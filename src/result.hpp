@@ -1,23 +1,33 @@
 #pragma once
 
+#include <algorithm>
+#include <charconv>
 #include <concepts>
+#include <cstddef>
 #include <functional>
-#include <iostream>  // needed for Printable<_>
+#include <iterator>
+#include <memory>
 #include <optional>
-#include <sstream>
+#include <ostream>
+#include <source_location>
+#include <span>
+#include <sstream>  // fallback for Printable<_> payloads
 #include <stdexcept>
+#include <string>
+#include <string_view>
 #include <type_traits>
+#include <utility>
 
 namespace sundry {  // namespace sundry
   /**
    * @brief Concept ensuring that a given type can be pushed to
-   * `std::stringstream`.
+   * `std::ostream`.
    *
    * @tparam `T` type to be pushed to the stream.
    */
   template<typename T>
-  concept Printable = requires(T value) {
-    std::cout << value;  // TODO: problem - this requires cout object
+  concept Printable = requires(std::ostream &os, const T &value) {
+    os << value;
   };
 
   /**
@@ -114,6 +124,80 @@ namespace sundry {  // namespace sundry
     return false;
   }
 
+  namespace detail {
+    /// Payloads `format_to` can write: arithmetic, string-like, `Printable`.
+    template<typename T>
+    concept Writable = !std::is_void_v<T>
+                       && (std::is_arithmetic_v<T>
+                           || std::is_convertible_v<const T &, std::string_view>
+                           || Printable<T>);
+
+    template<typename OutputIt>
+    OutputIt write(OutputIt out, std::string_view text) {
+      return std::copy(text.begin(), text.end(), out);
+    }
+
+    /**
+     * @brief Writes \p value to \p out. Arithmetic values go through
+     * `std::to_chars` (locale-independent, no allocation); only `Printable`
+     * class types fall back to `std::ostringstream`.
+     */
+    template<typename OutputIt, Writable V>
+    OutputIt write_value(OutputIt out, const V &value) {
+      if constexpr(std::is_same_v<V, bool>)
+        return write(out, value ? "true" : "false");
+      else if constexpr(std::is_same_v<V, char>) {
+        *out = value;
+        return ++out;
+      } else if constexpr(std::is_arithmetic_v<V>) {
+        char buffer[128];
+        auto [end, ec] = std::to_chars(buffer, buffer + sizeof buffer, value);
+        return std::copy(buffer, end, out);
+      } else if constexpr(std::is_convertible_v<const V &, std::string_view>)
+        return write(out, std::string_view(value));
+      else {
+        std::ostringstream os;
+        os << value;
+        return write(out, os.str());
+      }
+    }
+
+    /// Writes \p wrapper as `<name>(<payload>)`; `<name>()` for `void`.
+    template<typename OutputIt, typename W>
+    OutputIt write_wrapped(OutputIt out, std::string_view name,
+                           const W &wrapper) {
+      out = write(out, name);
+      out = write(out, "(");
+      if constexpr(!std::is_void_v<typename W::value_t>)
+        out = write_value(out, wrapper.value);
+      return write(out, ")");
+    }
+  }  // namespace detail
+
+  /**
+   * @brief Tag selecting in-place construction of `Ok` inside `Result`.
+   */
+  struct in_place_ok_t {
+    explicit in_place_ok_t() = default;
+  };
+  inline constexpr in_place_ok_t in_place_ok {};
+
+  /**
+   * @brief Tag selecting in-place construction of `Err` inside `Result`.
+   */
+  struct in_place_err_t {
+    explicit in_place_err_t() = default;
+  };
+  inline constexpr in_place_err_t in_place_err {};
+
+  namespace detail {
+    /// Payloads in-place constructible from \p Args; `void` from nothing.
+    template<typename V, typename... Args>
+    concept InPlaceConstructible =
+        (std::is_void_v<V> && sizeof...(Args) == 0)
+        || std::constructible_from<V, Args...>;
+  }  // namespace detail
+
   /**
    * @brief Monadic result type.
    *
@@ -139,21 +223,56 @@ namespace sundry {  // namespace sundry
     // Result(Err<E> value) : ok_flag_(false), err_value_(value) {}
     Result(const Ok<T> &value) : ok_flag_(true), ok_value_(value) {}
     Result(const Err<E> &value) : ok_flag_(false), err_value_(value) {}
-    Result(Ok<T> &&value) : ok_flag_(true), ok_value_(value) {}
-    Result(Err<E> &&value) : ok_flag_(false), err_value_(value) {}
+    Result(Ok<T> &&value) : ok_flag_(true), ok_value_(std::move(value)) {}
+    Result(Err<E> &&value) : ok_flag_(false), err_value_(std::move(value)) {}
+
+    /**
+     * @brief Constructs `Ok` value in place from \p args, without
+     * intermediate moves.
+     */
+    template<typename... Args>
+    requires detail::InPlaceConstructible<T, Args...>
+    explicit Result(in_place_ok_t, Args &&...args)
+        : ok_flag_(true),
+          ok_value_(wrap_in_place<Ok<T>>(std::forward<Args>(args)...)) {}
+
+    /**
+     * @brief Constructs `Err` value in place from \p args, without
+     * intermediate moves.
+     */
+    template<typename... Args>
+    requires detail::InPlaceConstructible<E, Args...>
+    explicit Result(in_place_err_t, Args &&...args)
+        : ok_flag_(false),
+          err_value_(wrap_in_place<Err<E>>(std::forward<Args>(args)...)) {}
 
+    // Union members are not constructed implicitly, hence `construct_at`.
     Result(const Result<T, E> &other) : ok_flag_(other.ok_flag_) {
       if(ok_flag_)
-        ok_value_ = other.ok_value_;
+        std::construct_at(&ok_value_, other.ok_value_);
       else
-        err_value_ = other.err_value_;
+        std::construct_at(&err_value_, other.err_value_);
     }
 
-    Result(Result<T, E> &&other) : ok_flag_(ok_flag_) {
+    Result(Result<T, E> &&other) noexcept(
+        std::is_nothrow_move_constructible_v<Ok<T>>
+        && std::is_nothrow_move_constructible_v<Err<E>>)
+        : ok_flag_(other.ok_flag_) {
+      if(ok_flag_)
+        std::construct_at(&ok_value_, std::move(other.ok_value_));
+      else
+        std::construct_at(&err_value_, std::move(other.err_value_));
+    }
+
+    ~Result() requires(std::is_trivially_destructible_v<Ok<T>>
+                           &&std::is_trivially_destructible_v<Err<E>>)
+    = default;
+
+    ~Result() {
       if(ok_flag_)
-        ok_value_ = std::move(other.ok_value_);
+        std::destroy_at(&ok_value_);
       else
-        err_value_ = std::move(other.err_value_);
+        std::destroy_at(&err_value_);
     }
 
     template<typename U, typename = typename std::enable_if_t<
@@ -278,7 +397,7 @@ namespace sundry {  // namespace sundry
      */
     // TODO: add equally comparable
     template<typename U = T>
-    bool contains(const U &value) {
+    bool contains(const U &value) const {
       return is_ok() && ok_value_.value == value;
     }
 
@@ -293,7 +412,7 @@ namespace sundry {  // namespace sundry
      */
     // TODO: add equally comparable
     template<typename U = E>
-    bool contains_err(const U &value) {
+    bool contains_err(const U &value) const {
       return is_err() && err_value_.value == value;
     }
 
@@ -346,11 +465,24 @@ namespace sundry {  // namespace sundry
      * empty if result contains `Err`.
      */
     template<typename U = T>
-    std::optional<U> ok() const noexcept {
+    std::optional<U> ok() const & noexcept {
       if(is_ok()) return std::optional<U>(ok_value_.value);
       return std::optional<U>();
     }
 
+    /**
+     * @brief Moves contents of `Ok` of an expiring result into
+     * `std::optional`. Works for move-only `T`.
+     *
+     * @return `std::optional<U>` with `Ok` contents if result contains `Ok`,
+     * empty if result contains `Err`.
+     */
+    template<typename U = T>
+    std::optional<U> ok() && {
+      if(is_ok()) return std::optional<U>(std::move(ok_value_.value));
+      return std::optional<U>();
+    }
+
     /**
      * @brief Returns `std::optional` with contents of `Err`. Returns empty
      * option if result contains `Ok`.
@@ -362,11 +494,86 @@ namespace sundry {  // namespace sundry
      * empty if result contains `Ok`.
      */
     template<typename U = E>
-    std::optional<U> err() const noexcept {
+    std::optional<U> err() const & noexcept {
       if(is_err()) return std::optional<U>(err_value_.value);
       return std::optional<U>();
     }
 
+    /**
+     * @brief Moves contents of `Err` of an expiring result into
+     * `std::optional`. Works for move-only `E`.
+     *
+     * @return `std::optional<U>` with `Err` contents if result contains `Err`,
+     * empty if result contains `Ok`.
+     */
+    template<typename U = E>
+    std::optional<U> err() && {
+      if(is_err()) return std::optional<U>(std::move(err_value_.value));
+      return std::optional<U>();
+    }
+
+    /**
+     * @brief Optional reference to contents of `Ok`; nothing is copied.
+     *
+     * @return pointer to `Ok` contents; `nullptr` if result contains `Err`.
+     */
+    template<typename U = T>
+    requires(!std::is_void_v<U>) const U *ok_ptr() const noexcept {
+      return is_ok() ? &ok_value_.value : nullptr;
+    }
+
+    template<typename U = T>
+    requires(!std::is_void_v<U>) U *ok_ptr() noexcept {
+      return is_ok() ? &ok_value_.value : nullptr;
+    }
+
+    /**
+     * @brief Optional reference to contents of `Err`; nothing is copied.
+     *
+     * @return pointer to `Err` contents; `nullptr` if result contains `Ok`.
+     */
+    template<typename U = E>
+    requires(!std::is_void_v<U>) const U *err_ptr() const noexcept {
+      return is_err() ? &err_value_.value : nullptr;
+    }
+
+    template<typename U = E>
+    requires(!std::is_void_v<U>) U *err_ptr() noexcept {
+      return is_err() ? &err_value_.value : nullptr;
+    }
+
+    /**
+     * @brief Hands `Err` to \p sink along with the call site; does nothing
+     * but a flag test for `Ok`.
+     *
+     * @param[in] sink anything with `log(const Err<E> &, source_location)`,
+     * e.g. `ErrorLog` from `error_log.hpp`.
+     * @return this result, for chaining.
+     */
+    template<typename S>
+    requires requires(S &s, const Err<E> &e, std::source_location site) {
+      s.log(e, site);
+    }
+    const Result &log_if_err(
+        S &sink,
+        std::source_location site = std::source_location::current()) const & {
+      if(is_err()) [[unlikely]]
+        sink.log(err_value_, site);
+      return *this;
+    }
+
+    template<typename S>
+    requires requires(S &s, const Err<E> &e, std::source_location site) {
+      s.log(e, site);
+    }
+    Result log_if_err(
+        S &sink,
+        std::source_location site = std::source_location::current()) && {
+      if(is_err()) [[unlikely]]
+        sink.log(err_value_, site);
+      return std::move(*this);
+    }
+
     /**
      * @brief Attempts to return contents of `Ok`. Throws exception on failure.
      *
@@ -374,13 +581,22 @@ namespace sundry {  // namespace sundry
      * @throws `std::runtime_error` with relevant error message if result
      * contains `Err`.
      */
-    T unwrap() const {
+    T unwrap() const & {
       if(is_ok()) return ok_value_.value;
-      std::stringstream err_msg;
-      err_msg << "called `Result::unwrap()` on `Err` value";
-      if constexpr(Printable<E>) err_msg << ' ' << err_value_.value;
-      err_msg << std::endl;
-      throw std::runtime_error(err_msg.str());
+      throw_unwrap_err();
+    }
+
+    /**
+     * @brief Attempts to move contents of `Ok` out of an expiring result.
+     * Throws exception on failure. Works for move-only `T`.
+     *
+     * @return `T` contents of `Ok`.
+     * @throws `std::runtime_error` with relevant error message if result
+     * contains `Err`.
+     */
+    T unwrap() && {
+      if(is_ok()) return std::move(ok_value_.value);
+      throw_unwrap_err();
     }
 
     /**
@@ -392,13 +608,36 @@ namespace sundry {  // namespace sundry
      */
     E unwrap_err() const {
       if(is_err()) return err_value_.value;
-      std::stringstream err_msg;
-      err_msg << "called `Result::unwrap_err()` on `Ok` value";
-      if constexpr(Printable<T>) { err_msg << ' ' << ok_value_.value; }
-      err_msg << std::endl;
-      throw std::runtime_error(err_msg.str());
+      std::string err_msg = "called `Result::unwrap_err()` on `Ok` value";
+      if constexpr(detail::Writable<T>)
+        detail::write_value(std::back_inserter(err_msg += ' '),
+                            ok_value_.value);
+      throw std::runtime_error(err_msg += '\n');
+    }
+
+   private:
+    [[noreturn]] void throw_unwrap_err() const {
+      std::string err_msg = "called `Result::unwrap()` on `Err` value";
+      if constexpr(detail::Writable<E>)
+        detail::write_value(std::back_inserter(err_msg += ' '),
+                            err_value_.value);
+      throw std::runtime_error(err_msg += '\n');
+    }
+
+    // Returned prvalue initializes the union member directly. A single
+    // argument goes through `static_cast`: `V(arg)` would be a C-style cast.
+    template<typename W, typename... Args>
+    static W wrap_in_place(Args &&...args) {
+      using V = typename W::value_t;
+      if constexpr(std::is_void_v<V>)
+        return W {};
+      else if constexpr(sizeof...(Args) == 1)
+        return W {static_cast<V>(std::forward<Args>(args))...};
+      else
+        return W {V(std::forward<Args>(args)...)};
     }
 
+   public:
     template<typename F, typename V>
     using RType = typename std::invoke_result<F, V>::type;
 
@@ -435,6 +674,20 @@ namespace sundry {  // namespace sundry
     }
   };
 
+  namespace detail {
+    template<typename T>
+    struct is_result : std::false_type {};
+
+    template<typename T, typename E>
+    struct is_result<Result<T, E>> : std::true_type {};
+  }  // namespace detail
+
+  /**
+   * @brief Concept satisfied by (cv-qualified references to) `Result<T, E>`.
+   */
+  template<typename R>
+  concept ResultType = detail::is_result<std::remove_cvref_t<R>>::value;
+
   template<typename T, typename E>
   Result<T, E> make_ok(const T &value) {
     return {Ok(value)};
@@ -454,4 +707,82 @@ namespace sundry {  // namespace sundry
   Result<T, E> make_err() {
     return {Err<void> {}};
   }
+
+  /**
+   * @brief Writes \p value as `Ok(<payload>)` to \p out without going
+   * through streams or locales.
+   *
+   * @return iterator past the last written character.
+   */
+  template<std::output_iterator<char> OutputIt, typename T>
+  requires std::is_void_v<T> || detail::Writable<T>
+  OutputIt format_to(OutputIt out, const Ok<T> &value) {
+    return detail::write_wrapped(out, "Ok", value);
+  }
+
+  /**
+   * @brief Writes \p value as `Err(<payload>)` to \p out without going
+   * through streams or locales.
+   *
+   * @return iterator past the last written character.
+   */
+  template<std::output_iterator<char> OutputIt, typename E>
+  requires std::is_void_v<E> || detail::Writable<E>
+  OutputIt format_to(OutputIt out, const Err<E> &value) {
+    return detail::write_wrapped(out, "Err", value);
+  }
+
+  /**
+   * @brief Writes \p value as `Ok(<payload>)` or `Err(<payload>)` to \p out
+   * without going through streams or locales.
+   *
+   * @return iterator past the last written character.
+   */
+  template<std::output_iterator<char> OutputIt, typename T, typename E>
+  requires(std::is_void_v<T> || detail::Writable<T>)
+      && (std::is_void_v<E> || detail::Writable<E>)
+  OutputIt format_to(OutputIt out, const Result<T, E> &value) {
+    if(value.is_ok()) return format_to(out, value.ok_value_);
+    return format_to(out, value.err_value_);
+  }
+
+  namespace detail {
+    /// Output iterator writing into a fixed buffer and counting overflow.
+    struct BoundedWriter {
+      using difference_type = std::ptrdiff_t;
+
+      char *cur;
+      char *end;
+      std::size_t size = 0;
+
+      BoundedWriter &operator*() { return *this; }
+      BoundedWriter &operator++() { return *this; }
+      BoundedWriter operator++(int) { return *this; }
+      BoundedWriter &operator=(char c) {
+        if(cur != end) *cur++ = c;
+        ++size;
+        return *this;
+      }
+    };
+  }  // namespace detail
+
+  /**
+   * @brief Formats \p value (`Ok`, `Err` or `Result`) into caller-provided
+   * \p buffer. Never allocates for arithmetic and string-like payloads.
+   *
+   * @return `Ok` with number of written characters; `Err` with required
+   * buffer size if \p buffer is too small (its contents are then truncated).
+   */
+  template<typename V>
+  requires requires(detail::BoundedWriter out, const V &value) {
+    sundry::format_to(out, value);
+  }
+  Result<std::size_t, std::size_t> format_into(std::span<char> buffer,
+                                               const V &value) {
+    auto out = sundry::format_to(
+        detail::BoundedWriter {buffer.data(), buffer.data() + buffer.size()},
+        value);
+    if(out.size > buffer.size()) return {Err<std::size_t> {out.size}};
+    return {Ok<std::size_t> {out.size}};
+  }
 }  // namespace sundry
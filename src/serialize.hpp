@@ -0,0 +1,617 @@
+#pragma once
+
+#include "result.hpp"
+
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <limits>
+#include <ostream>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+/**
+ * @brief Compact binary encoding of `Result`s for local IPC and spill files.
+ *
+ * A record is a one-byte tag (`1` for `Ok`, `0` for `Err`) followed by the
+ * payload encoded with `Codec`; `void` payloads take no bytes. A batch is a
+ * plain concatenation of records, so it can be appended to and streamed
+ * without framing. Values are stored in host byte order and without
+ * alignment, hence the encoding is meant to be read back on the same
+ * architecture.
+ */
+namespace sundry::serialize {  // namespace sundry::serialize
+  /**
+   * @brief Reason of a decode failure.
+   */
+  enum class DecodeErrc : std::uint8_t {
+    truncated,    ///< Input ends in the middle of a record.
+    invalid_tag,  ///< Record starts with neither `Ok` nor `Err` tag.
+    trailing,     ///< Input holds more than a single record.
+  };
+
+  /**
+   * @brief Compact decode error: reason and offset of the offending record.
+   */
+  struct DecodeError {
+    DecodeErrc code;         ///< Reason of failure.
+    std::uint64_t position;  ///< Offset from the beginning of input.
+
+    bool operator==(const DecodeError &) const = default;
+  };
+
+  /**
+   * @brief Prints \p error as e.g. `truncated record at 5`; makes
+   * `DecodeError` `Printable`.
+   */
+  inline std::ostream &operator<<(std::ostream &os, const DecodeError &error) {
+    constexpr const char *names[] = {"truncated record", "invalid tag",
+                                     "trailing bytes"};
+    return os << names[static_cast<int>(error.code)] << " at "
+              << error.position;
+  }
+
+  /**
+   * @brief Payload encoding; specialize to support more types.
+   *
+   * A specialization provides:
+   * - `view_t` – type payloads are decoded to without copying the buffer;
+   * - `size(value)` – number of bytes `encode` writes;
+   * - `encode(out, value)` – writes \p value to \p out, returns end pointer;
+   * - `extent(in, available)` – encoded size of payload at \p in, `0` if the
+   *   first \p available bytes do not tell yet;
+   * - `view(in)` – decodes payload at \p in, which is known to be complete;
+   * - optionally `fixed_size`, if all values take the same number of bytes.
+   *
+   * @tparam T payload type.
+   */
+  template<typename T>
+  struct Codec;
+
+  /**
+   * @brief Payloads copied bytewise: trivially copyable non-pointer types.
+   */
+  template<typename T>
+  concept Trivial = std::is_trivially_copyable_v<T>
+                    && std::default_initializable<T> && !std::is_pointer_v<T>;
+
+  /**
+   * @brief Copies bytes of trivially copyable payloads.
+   */
+  template<Trivial T>
+  struct Codec<T> {
+    using view_t = T;  ///< Copied out, since payloads may be unaligned.
+
+    static constexpr std::size_t fixed_size = sizeof(T);
+
+    static constexpr std::size_t size(const T &) noexcept { return sizeof(T); }
+
+    static std::byte *encode(std::byte *out, const T &value) noexcept {
+      std::memcpy(out, &value, sizeof(T));
+      return out + sizeof(T);
+    }
+
+    static constexpr std::size_t extent(const std::byte *,
+                                        std::size_t) noexcept {
+      return sizeof(T);
+    }
+
+    static T view(const std::byte *in) noexcept {
+      T value;
+      std::memcpy(&value, in, sizeof(T));
+      return value;
+    }
+  };
+
+  namespace detail {
+    /// Strings are prefixed with 32-bit length; views point into the buffer.
+    struct StringCodec {
+      using view_t = std::string_view;
+      using length_t = std::uint32_t;
+
+      /// @throw std::invalid_argument if \p value is too long for `length_t`.
+      static std::size_t size(std::string_view value) {
+        if(value.size() > std::numeric_limits<length_t>::max())
+          throw std::invalid_argument("String is too long to serialize.");
+        return sizeof(length_t) + value.size();
+      }
+
+      static std::byte *encode(std::byte *out, std::string_view value) {
+        auto length = static_cast<length_t>(value.size());
+        std::memcpy(out, &length, sizeof length);
+        if(length) std::memcpy(out + sizeof length, value.data(), length);
+        return out + sizeof length + length;
+      }
+
+      static std::size_t extent(const std::byte *in,
+                                std::size_t available) noexcept {
+        if(available < sizeof(length_t)) return 0;
+        length_t length;
+        std::memcpy(&length, in, sizeof length);
+        return sizeof length + length;
+      }
+
+      static std::string_view view(const std::byte *in) noexcept {
+        length_t length;
+        std::memcpy(&length, in, sizeof length);
+        return {reinterpret_cast<const char *>(in + sizeof length), length};
+      }
+    };
+  }  // namespace detail
+
+  template<>
+  struct Codec<std::string> : detail::StringCodec {};
+
+  template<>
+  struct Codec<std::string_view> : detail::StringCodec {};
+
+  namespace detail {
+    template<typename T>
+    struct payload_view {
+      using type = typename Codec<T>::view_t;
+    };
+
+    template<>
+    struct payload_view<void> {
+      using type = void;
+    };
+  }  // namespace detail
+
+  /**
+   * @brief Type payload `T` is decoded to by views, e.g. `std::string_view`
+   * for `std::string`.
+   */
+  template<typename T>
+  using payload_view_t = typename detail::payload_view<T>::type;
+
+  /**
+   * @brief Decoded record referring to the encoded buffer.
+   */
+  template<typename T, typename E>
+  using ResultView = Result<payload_view_t<T>, payload_view_t<E>>;
+
+  /**
+   * @brief Payloads encoded with the same number of bytes for every value.
+   */
+  template<typename T>
+  concept FixedSize = std::is_void_v<T> || requires {
+    { Codec<T>::fixed_size } -> std::convertible_to<std::size_t>;
+  };
+
+  namespace detail {
+    inline Err<DecodeError> fail(DecodeErrc code, std::uint64_t position) {
+      return {{code, position}};
+    }
+
+    template<FixedSize T>
+    constexpr std::size_t fixed_size() {
+      if constexpr(std::is_void_v<T>)
+        return 0;
+      else
+        return Codec<T>::fixed_size;
+    }
+
+    template<typename W>
+    std::size_t payload_size(const W &wrapper) {
+      using V = typename W::value_t;
+      if constexpr(std::is_void_v<V>)
+        return 0;
+      else
+        return Codec<V>::size(wrapper.value);
+    }
+
+    template<typename W>
+    std::byte *encode_payload(std::byte *out, const W &wrapper) {
+      using V = typename W::value_t;
+      if constexpr(std::is_void_v<V>)
+        return out;
+      else
+        return Codec<V>::encode(out, wrapper.value);
+    }
+
+    /// Writes record without bounds checks; see `encoded_size`.
+    template<typename T, typename E>
+    std::byte *write_record(std::byte *out, const Result<T, E> &value) {
+      *out++ = std::byte {value.is_ok()};
+      if(value.is_ok()) return encode_payload(out, value.ok_value_);
+      return encode_payload(out, value.err_value_);
+    }
+
+    /// Size of record with payload \p V at \p first; `0` if unknown yet.
+    template<typename V>
+    std::size_t record_extent(const std::byte *first,
+                              std::size_t available) noexcept {
+      if constexpr(std::is_void_v<V>)
+        return 1;
+      else {
+        auto payload = Codec<V>::extent(first + 1, available - 1);
+        return payload ? payload + 1 : 0;
+      }
+    }
+
+    /**
+     * @brief Size of record at \p first; `0` if the first \p available bytes
+     * do not tell yet.
+     *
+     * @param[in] position offset of \p first reported on failure.
+     */
+    template<typename T, typename E>
+    Result<std::size_t, DecodeError>
+    extent(const std::byte *first, std::size_t available,
+           std::uint64_t position) {
+      if(available == 0) return {Ok<std::size_t> {0}};
+      switch(std::to_integer<std::uint8_t>(*first)) {
+        case 1: return {Ok<std::size_t> {record_extent<T>(first, available)}};
+        case 0: return {Ok<std::size_t> {record_extent<E>(first, available)}};
+        default: return fail(DecodeErrc::invalid_tag, position);
+      }
+    }
+
+    /// Size of record at \p first, which is known to be valid.
+    template<typename T, typename E>
+    std::size_t record_size(const std::byte *first) noexcept {
+      constexpr auto unbounded = std::numeric_limits<std::size_t>::max();
+      if(std::to_integer<std::uint8_t>(*first))
+        return record_extent<T>(first, unbounded);
+      return record_extent<E>(first, unbounded);
+    }
+
+    template<typename W, typename Tag, typename V>
+    W view_payload(Tag tag, const std::byte *in) {
+      if constexpr(std::is_void_v<V>)
+        return W(tag);
+      else
+        return W(tag, Codec<V>::view(in));
+    }
+
+    /// Decodes record at \p first, which is known to be complete, into
+    /// \p R: either `ResultView<T, E>` or `Result<T, E>`.
+    template<typename T, typename E, typename R = ResultView<T, E>>
+    R view_record(const std::byte *first) {
+      if(std::to_integer<std::uint8_t>(*first))
+        return view_payload<R, in_place_ok_t, T>(in_place_ok, first + 1);
+      return view_payload<R, in_place_err_t, E>(in_place_err, first + 1);
+    }
+
+    /// Decodes record at \p first, constructing owned payloads straight
+    /// from the buffer.
+    template<typename T, typename E>
+    Result<T, E> decode_record(const std::byte *first) {
+      return view_record<T, E, Result<T, E>>(first);
+    }
+
+    /// Appends record at \p first to \p out, constructing it in place.
+    template<typename T, typename E, typename C>
+    void emplace_record(C &out, const std::byte *first) {
+      if(std::to_integer<std::uint8_t>(*first)) {
+        if constexpr(std::is_void_v<T>)
+          out.emplace_back(in_place_ok);
+        else
+          out.emplace_back(in_place_ok, Codec<T>::view(first + 1));
+      } else if constexpr(std::is_void_v<E>)
+        out.emplace_back(in_place_err);
+      else
+        out.emplace_back(in_place_err, Codec<E>::view(first + 1));
+    }
+  }  // namespace detail
+
+  /**
+   * @brief Copies payload of \p view out of the encoded buffer.
+   */
+  template<typename T, typename E>
+  Result<T, E> materialize(ResultView<T, E> &&view) {
+    using Out = Result<T, E>;
+    if(view.is_ok()) {
+      if constexpr(std::is_void_v<T>)
+        return Out(in_place_ok);
+      else
+        return Out(in_place_ok, std::move(view.ok_value_.value));
+    }
+    if constexpr(std::is_void_v<E>)
+      return Out(in_place_err);
+    else
+      return Out(in_place_err, std::move(view.err_value_.value));
+  }
+
+  /**
+   * @brief Returns number of bytes `encode` appends for \p value.
+   */
+  template<typename T, typename E>
+  std::size_t encoded_size(const Result<T, E> &value) {
+    if(value.is_ok()) return 1 + detail::payload_size(value.ok_value_);
+    return 1 + detail::payload_size(value.err_value_);
+  }
+
+  /**
+   * @brief Appends record holding \p value to \p out.
+   */
+  template<typename T, typename E>
+  void encode(const Result<T, E> &value, std::vector<std::byte> &out) {
+    auto size = out.size();
+    out.resize(size + encoded_size(value));
+    detail::write_record(out.data() + size, value);
+  }
+
+  /**
+   * @brief Decodes \p bytes holding exactly one record without copying
+   * payloads out of the buffer.
+   *
+   * @return view valid as long as \p bytes are, or `DecodeError`.
+   */
+  template<typename T, typename E>
+  Result<ResultView<T, E>, DecodeError> view(std::span<const std::byte> bytes) {
+    auto size = detail::extent<T, E>(bytes.data(), bytes.size(), 0);
+    if(size.is_err()) return {size.err_value_};
+    auto n = size.ok_value_.value;
+    if(n == 0 || n > bytes.size()) return detail::fail(DecodeErrc::truncated, 0);
+    if(n < bytes.size()) return detail::fail(DecodeErrc::trailing, n);
+    return Result<ResultView<T, E>, DecodeError>(
+        in_place_ok, detail::view_record<T, E>(bytes.data()));
+  }
+
+  /**
+   * @brief Decodes \p bytes holding exactly one record.
+   */
+  template<typename T, typename E>
+  Result<Result<T, E>, DecodeError> decode(std::span<const std::byte> bytes) {
+    auto viewed = view<T, E>(bytes);
+    if(viewed.is_err()) return {viewed.err_value_};
+    return Result<Result<T, E>, DecodeError>(
+        in_place_ok, materialize<T, E>(std::move(viewed.ok_value_.value)));
+  }
+
+  /**
+   * @brief Zero-copy view of a batch of records.
+   *
+   * Records are validated once by `parse`; iteration then decodes them
+   * without bounds checks, yielding `ResultView`s which refer to the
+   * underlying buffer.
+   *
+   * @tparam T Ok value type.
+   * @tparam E Error value type.
+   */
+  template<typename T, typename E>
+  class BatchView {
+   public:
+    /**
+     * @brief Forward iterator decoding records on dereference.
+     */
+    class iterator {
+     public:
+      using value_type = ResultView<T, E>;
+      using difference_type = std::ptrdiff_t;
+      using iterator_concept = std::forward_iterator_tag;
+
+      iterator() noexcept = default;
+
+      value_type operator*() const { return detail::view_record<T, E>(pos_); }
+
+      iterator &operator++() noexcept {
+        pos_ += detail::record_size<T, E>(pos_);
+        return *this;
+      }
+
+      iterator operator++(int) noexcept {
+        auto old = *this;
+        ++*this;
+        return old;
+      }
+
+      bool operator==(const iterator &) const = default;
+
+     private:
+      friend class BatchView;
+
+      explicit iterator(const std::byte *pos) noexcept : pos_(pos) {}
+
+      const std::byte *pos_ = nullptr;
+    };
+
+    /**
+     * @brief Validates records in \p bytes.
+     *
+     * @return view valid as long as \p bytes are, or `DecodeError` of the
+     * first malformed record.
+     */
+    static Result<BatchView, DecodeError>
+    parse(std::span<const std::byte> bytes) {
+      BatchView batch;
+      batch.bytes_ = bytes;
+      auto first = bytes.data(), last = first + bytes.size();
+      for(auto p = first; p != last; ++batch.size_) {
+        auto available = static_cast<std::size_t>(last - p);
+        auto extent = detail::extent<T, E>(p, available, p - first);
+        if(extent.is_err()) return {extent.err_value_};
+        auto size = extent.ok_value_.value;
+        if(size == 0 || size > available)
+          return detail::fail(DecodeErrc::truncated, p - first);
+        p += size;
+      }
+      return {Ok<BatchView> {batch}};
+    }
+
+    iterator begin() const noexcept { return iterator(bytes_.data()); }
+
+    iterator end() const noexcept {
+      return iterator(bytes_.data() + bytes_.size());
+    }
+
+    /**
+     * @brief Returns number of records.
+     */
+    std::size_t size() const noexcept { return size_; }
+
+    bool empty() const noexcept { return size_ == 0; }
+
+    /**
+     * @brief Returns underlying buffer.
+     */
+    std::span<const std::byte> bytes() const noexcept { return bytes_; }
+
+   private:
+    BatchView() noexcept = default;
+
+    std::span<const std::byte> bytes_;
+    std::size_t size_ = 0;
+  };
+
+  /**
+   * @brief Streaming encoder appending records to an internal buffer.
+   *
+   * Flush `bytes()` to a file or socket and `clear()` whenever convenient;
+   * since batches are not framed, flushed pieces simply concatenate.
+   *
+   * @tparam T Ok value type.
+   * @tparam E Error value type.
+   */
+  template<typename T, typename E>
+  class Encoder {
+   public:
+    /**
+     * @brief Appends record holding \p value.
+     */
+    void push(const Result<T, E> &value) { encode(value, buffer_); }
+
+    /**
+     * @brief Appends records holding \p values.
+     *
+     * The buffer is grown once; for fixed size payloads its size is
+     * computed from the number of `Ok`s, and each record is then written
+     * with constant-size copies and no bounds checks.
+     */
+    void push(std::span<const Result<T, E>> values) {
+      std::size_t size = 0;
+      if constexpr(FixedSize<T> && FixedSize<E>) {
+        std::size_t oks = 0;
+        for(auto &value : values) oks += value.is_ok();
+        size = values.size() + oks * detail::fixed_size<T>()
+               + (values.size() - oks) * detail::fixed_size<E>();
+      } else
+        for(auto &value : values) size += encoded_size(value);
+      auto used = buffer_.size();
+      buffer_.resize(used + size);
+      auto out = buffer_.data() + used;
+      for(auto &value : values) out = detail::write_record(out, value);
+    }
+
+    /**
+     * @brief Returns records encoded since the last `clear()`.
+     */
+    std::span<const std::byte> bytes() const noexcept { return buffer_; }
+
+    /**
+     * @brief Drops encoded records, keeping allocated memory.
+     */
+    void clear() noexcept { buffer_.clear(); }
+
+   private:
+    std::vector<std::byte> buffer_;
+  };
+
+  /**
+   * @brief Streaming decoder accepting a batch in arbitrary chunks.
+   *
+   * Records are decoded straight from the chunks; only a record split
+   * between two chunks is copied aside. After a `DecodeError` the decoder
+   * must not be used any further.
+   *
+   * @tparam T Ok value type.
+   * @tparam E Error value type.
+   */
+  template<typename T, typename E>
+  class Decoder {
+   public:
+    /**
+     * @brief Decodes records completed by \p chunk into \p out.
+     *
+     * @return number of decoded records, or `DecodeError` with offset from
+     * the beginning of the stream.
+     */
+    template<std::output_iterator<Result<T, E>> OutputIt>
+    Result<std::size_t, DecodeError> feed(std::span<const std::byte> chunk,
+                                          OutputIt out) {
+      return decode(chunk, [&](const std::byte *record) {
+        *out++ = detail::decode_record<T, E>(record);
+      });
+    }
+
+    /**
+     * @brief Appends records completed by \p chunk to \p out, constructing
+     * them in place.
+     *
+     * @return number of decoded records, or `DecodeError` with offset from
+     * the beginning of the stream.
+     */
+    Result<std::size_t, DecodeError> feed(std::span<const std::byte> chunk,
+                                          std::vector<Result<T, E>> &out) {
+      return decode(chunk, [&](const std::byte *record) {
+        detail::emplace_record<T, E>(out, record);
+      });
+    }
+
+    /**
+     * @brief Checks that the stream ended on a record boundary.
+     */
+    Result<void, DecodeError> finish() const {
+      if(!pending_.empty())
+        return detail::fail(DecodeErrc::truncated, position_);
+      return {Ok<void> {}};
+    }
+
+    /**
+     * @brief Returns number of bytes of an incomplete record kept aside.
+     */
+    std::size_t pending() const noexcept { return pending_.size(); }
+
+   private:
+    /// Passes every complete record to \p emit.
+    template<typename F>
+    Result<std::size_t, DecodeError> decode(std::span<const std::byte> chunk,
+                                            F &&emit) {
+      std::size_t count = 0;
+      // Completes a record split between chunks, reading its header byte by
+      // byte until its size is known.
+      while(!pending_.empty()) {
+        auto extent = detail::extent<T, E>(pending_.data(), pending_.size(),
+                                           position_);
+        if(extent.is_err()) return {extent.err_value_};
+        auto size = extent.ok_value_.value;
+        if(size == pending_.size()) {
+          emit(pending_.data());
+          position_ += size;
+          pending_.clear();
+          ++count;
+          break;
+        }
+        if(chunk.empty()) return {Ok<std::size_t> {count}};
+        auto take = std::min(size ? size - pending_.size() : 1, chunk.size());
+        pending_.insert(pending_.end(), chunk.begin(), chunk.begin() + take);
+        chunk = chunk.subspan(take);
+      }
+      auto first = chunk.data(), last = first + chunk.size();
+      while(first != last) {
+        auto available = static_cast<std::size_t>(last - first);
+        auto extent = detail::extent<T, E>(first, available, position_);
+        if(extent.is_err()) return {extent.err_value_};
+        auto size = extent.ok_value_.value;
+        if(size == 0 || size > available) break;
+        emit(first);
+        first += size;
+        position_ += size;
+        ++count;
+      }
+      pending_.assign(first, last);
+      return {Ok<std::size_t> {count}};
+    }
+
+    std::vector<std::byte> pending_;
+    std::uint64_t position_ = 0;  ///< Stream offset of the next record.
+  };
+}  // namespace sundry::serialize
@@ -0,0 +1,156 @@
+#pragma once
+
+#include "result.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <concepts>
+#include <new>
+#include <thread>
+#include <utility>
+
+namespace sundry {  // namespace sundry
+  /**
+   * @brief One-shot slot handing a `Result<T, E>` over to other threads.
+   *
+   * Lightweight replacement for `std::promise<Result<T, E>>` /
+   * `std::future`: the value is stored inline (no shared state allocation)
+   * and published with a single atomic transition. Waiters spin for a while
+   * and then park on `std::atomic::wait`; the setter only issues a wake-up
+   * when someone is actually parked.
+   *
+   * The slot is neither copyable nor movable; share it by reference and keep
+   * it alive until all waiters are done.
+   *
+   * @tparam T Ok value type.
+   * @tparam E Error value type.
+   */
+  template<typename T, typename E>
+  class SharedResult {
+   public:
+    using value_t = Result<T, E>;  ///< Alias for stored type.
+
+    SharedResult() = default;
+    SharedResult(const SharedResult &) = delete;
+    SharedResult &operator=(const SharedResult &) = delete;
+
+    ~SharedResult() {
+      if(state_.load(std::memory_order_acquire) & ready_)
+        std::destroy_at(get());
+    }
+
+    /**
+     * @brief Constructs `Ok` value in place from \p args and publishes it.
+     *
+     * @return `true` if value was set by this call.
+     * @return `false` if slot was already set; \p args are left untouched.
+     * @throw anything constructing the value throws; the slot stays unset.
+     */
+    template<typename... Args>
+    requires std::constructible_from<value_t, in_place_ok_t, Args...>
+    bool set_ok(Args &&...args) {
+      return set(in_place_ok, std::forward<Args>(args)...);
+    }
+
+    /**
+     * @brief Constructs `Err` value in place from \p args and publishes it.
+     *
+     * @return `true` if value was set by this call.
+     * @return `false` if slot was already set; \p args are left untouched.
+     * @throw anything constructing the value throws; the slot stays unset.
+     */
+    template<typename... Args>
+    requires std::constructible_from<value_t, in_place_err_t, Args...>
+    bool set_err(Args &&...args) {
+      return set(in_place_err, std::forward<Args>(args)...);
+    }
+
+    /**
+     * @brief Checks if value was published.
+     */
+    bool is_ready() const noexcept {
+      return state_.load(std::memory_order_acquire) & ready_;
+    }
+
+    /**
+     * @brief Returns published value without blocking.
+     *
+     * @return pointer to stored result; `nullptr` if it is not ready yet.
+     */
+    const value_t *try_get() const noexcept {
+      return is_ready() ? get() : nullptr;
+    }
+
+    /**
+     * @brief Blocks until value is published.
+     *
+     * @param[in] spins number of polls before parking the thread.
+     * @return reference to stored result, valid for the lifetime of the slot.
+     */
+    const value_t &wait(std::size_t spins = 1024) const noexcept {
+      for(std::size_t i = 0; i < spins; ++i)
+        if(is_ready()) return *get();
+      auto state = state_.fetch_or(waiting_, std::memory_order_acquire)
+                   | waiting_;
+      while(!(state & ready_)) {
+        state_.wait(state, std::memory_order_acquire);
+        state = state_.load(std::memory_order_acquire);
+      }
+      return *get();
+    }
+
+    /**
+     * @brief Blocks until value is published and moves it out, so move-only
+     * payloads can be handed over.
+     *
+     * For a single consumer: call it at most once, and do not read the slot
+     * through `wait`/`try_get` afterwards, as they see the moved-from value.
+     *
+     * @param[in] spins number of polls before parking the thread.
+     * @throw anything moving the value throws.
+     */
+    value_t take(std::size_t spins = 1024) {
+      wait(spins);
+      return std::move(*get());
+    }
+
+   private:
+    static constexpr std::uint8_t claimed_ = 1;  ///< A setter won the race.
+    static constexpr std::uint8_t ready_ = 2;    ///< Value is constructed.
+    static constexpr std::uint8_t waiting_ = 4;  ///< Someone is parked.
+
+    template<typename Tag, typename... Args>
+    bool set(Tag tag, Args &&...args) {
+      for(;;) {
+        auto state = state_.fetch_or(claimed_, std::memory_order_relaxed);
+        if(!(state & claimed_)) break;
+        // Winner may still throw and give the slot up; only report "already
+        // set" once its value is actually published.
+        while((state & (claimed_ | ready_)) == claimed_) {
+          std::this_thread::yield();
+          state = state_.load(std::memory_order_relaxed);
+        }
+        if(state & ready_) return false;
+      }
+      try {
+        std::construct_at(get(), tag, std::forward<Args>(args)...);
+      } catch(...) {
+        state_.fetch_and(~claimed_, std::memory_order_relaxed);
+        throw;
+      }
+      if(state_.fetch_or(ready_, std::memory_order_acq_rel) & waiting_)
+        state_.notify_all();
+      return true;
+    }
+
+    value_t *get() const noexcept {
+      return std::launder(
+          reinterpret_cast<value_t *>(const_cast<std::byte *>(storage_)));
+    }
+
+    alignas(value_t) std::byte storage_[sizeof(value_t)];
+    mutable std::atomic<std::uint8_t> state_ {0};
+  };
+}  // namespace sundry
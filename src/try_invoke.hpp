@@ -0,0 +1,225 @@
+#pragma once
+
+#include "result.hpp"
+
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <new>
+#include <ostream>
+#include <stdexcept>
+#include <system_error>
+#include <type_traits>
+#include <typeinfo>
+#include <utility>
+#include <variant>
+
+namespace sundry {  // namespace sundry
+  /**
+   * @brief Kind of exception caught by `try_invoke`.
+   */
+  enum class ErrorKind : std::uint8_t {
+    bad_alloc,           ///< `std::bad_alloc` and derived.
+    system_error,        ///< `std::system_error`; code is kept.
+    invalid_argument,    ///< `std::invalid_argument`.
+    domain_error,        ///< `std::domain_error`.
+    length_error,        ///< `std::length_error`.
+    out_of_range,        ///< `std::out_of_range`.
+    logic_error,         ///< Other `std::logic_error`.
+    range_error,         ///< `std::range_error`.
+    overflow_error,      ///< `std::overflow_error`.
+    underflow_error,     ///< `std::underflow_error`.
+    runtime_error,       ///< Other `std::runtime_error`.
+    bad_cast,            ///< `std::bad_cast`.
+    bad_variant_access,  ///< `std::bad_variant_access`.
+    exception,           ///< Other `std::exception`.
+    unknown,             ///< Anything not derived from `std::exception`.
+  };
+
+  /**
+   * @brief What `try_invoke` keeps of a caught exception.
+   */
+  enum class Capture : std::uint8_t {
+    kind,       ///< `ErrorKind` (and code of `std::system_error`) only.
+    exception,  ///< Also `std::exception_ptr` to the exception itself.
+  };
+
+  /**
+   * @brief Compact description of an exception caught by `try_invoke`.
+   *
+   * Holds no reference to the exception unless `Capture::exception` was
+   * requested, so handling it never touches the unwinder or the heap.
+   */
+  struct CaughtError {
+    ErrorKind kind;  ///< Kind of caught exception.
+    int code = 0;    ///< Error code of `std::system_error`, `0` otherwise.
+    const std::error_category *category = nullptr;  ///< Category of `code`.
+    std::exception_ptr exception = nullptr;  ///< Set for `Capture::exception`.
+
+    /**
+     * @brief Returns error code of a caught `std::system_error`; empty code
+     * for other kinds.
+     */
+    std::error_code error_code() const noexcept {
+      if(!category) return {};
+      return {code, *category};
+    }
+
+    /**
+     * @brief Returns exception for callers expecting one: the original, if
+     * it was captured, else a new exception of the type `kind` stands for.
+     * Messages of the original are only preserved in the former case.
+     */
+    std::exception_ptr into_exception() const {
+      if(exception) return exception;
+      switch(kind) {
+        case ErrorKind::bad_alloc: return make(std::bad_alloc());
+        case ErrorKind::system_error:
+          return make(std::system_error(error_code()));
+        case ErrorKind::invalid_argument:
+          return make(std::invalid_argument(message));
+        case ErrorKind::domain_error: return make(std::domain_error(message));
+        case ErrorKind::length_error: return make(std::length_error(message));
+        case ErrorKind::out_of_range: return make(std::out_of_range(message));
+        case ErrorKind::logic_error: return make(std::logic_error(message));
+        case ErrorKind::range_error: return make(std::range_error(message));
+        case ErrorKind::overflow_error:
+          return make(std::overflow_error(message));
+        case ErrorKind::underflow_error:
+          return make(std::underflow_error(message));
+        case ErrorKind::bad_cast: return make(std::bad_cast());
+        case ErrorKind::bad_variant_access:
+          return make(std::bad_variant_access());
+        default: return make(std::runtime_error(message));
+      }
+    }
+
+    /**
+     * @brief Throws exception returned by `into_exception`.
+     */
+    [[noreturn]] void rethrow() const {
+      std::rethrow_exception(into_exception());
+    }
+
+    /// Compares descriptions; captured exceptions are ignored.
+    bool operator==(const CaughtError &other) const noexcept {
+      return kind == other.kind && code == other.code
+             && category == other.category;
+    }
+
+   private:
+    static constexpr const char *message = "exception caught by try_invoke";
+
+    template<typename X>
+    static std::exception_ptr make(X &&error) {
+      return std::make_exception_ptr(std::forward<X>(error));
+    }
+  };
+
+  /**
+   * @brief Returns name of \p kind, e.g. `invalid_argument`.
+   */
+  inline const char *to_string(ErrorKind kind) noexcept {
+    constexpr const char *names[] = {
+        "bad_alloc",      "system_error",       "invalid_argument",
+        "domain_error",   "length_error",       "out_of_range",
+        "logic_error",    "range_error",        "overflow_error",
+        "underflow_error", "runtime_error",     "bad_cast",
+        "bad_variant_access", "exception",      "unknown"};
+    return names[static_cast<int>(kind)];
+  }
+
+  /**
+   * @brief Prints \p error as e.g. `system_error generic:2`; makes
+   * `CaughtError` `Printable`.
+   */
+  inline std::ostream &operator<<(std::ostream &os, const CaughtError &error) {
+    os << to_string(error.kind);
+    if(error.category) os << ' ' << error.category->name() << ':' << error.code;
+    return os;
+  }
+
+  namespace detail {
+    /// Builds `Err` for exception currently being handled.
+    template<typename Out, Capture C>
+    Out caught(ErrorKind kind, const std::error_code *code = nullptr) noexcept {
+      CaughtError error {kind};
+      if(code) {
+        error.code = code->value();
+        error.category = &code->category();
+      }
+      if constexpr(C == Capture::exception)
+        error.exception = std::current_exception();
+      return Out(in_place_err, std::move(error));
+    }
+  }  // namespace detail
+
+  /**
+   * @brief Invokes \p func with \p args, turning exceptions it throws into
+   * `Err<CaughtError>`.
+   *
+   * Meant for API boundaries with throwing code: the exception is caught in
+   * the frame right above \p func and travels further as a plain value, so
+   * the unwinder only ever walks a single frame.
+   *
+   * @tparam C what to keep of a caught exception.
+   * @return `Ok` with (a copy of) result of \p func, or `Err` describing the
+   * exception.
+   */
+  template<Capture C = Capture::kind, typename F, typename... Args>
+  requires std::invocable<F, Args...>
+  auto try_invoke(F &&func, Args &&...args) noexcept {
+    using R = std::remove_cvref_t<std::invoke_result_t<F, Args...>>;
+    using Out = Result<R, CaughtError>;
+    // Handlers go from most to least derived; a single catch (...) mapping
+    // the exception by rethrowing it would double the cost of every throw.
+    try {
+      if constexpr(std::is_void_v<R>) {
+        std::invoke(std::forward<F>(func), std::forward<Args>(args)...);
+        return Out(in_place_ok);
+      } else
+        return Out(in_place_ok, std::invoke(std::forward<F>(func),
+                                            std::forward<Args>(args)...));
+    } catch(const std::bad_alloc &) {
+      return detail::caught<Out, C>(ErrorKind::bad_alloc);
+    } catch(const std::system_error &e) {
+      return detail::caught<Out, C>(ErrorKind::system_error, &e.code());
+    } catch(const std::invalid_argument &) {
+      return detail::caught<Out, C>(ErrorKind::invalid_argument);
+    } catch(const std::domain_error &) {
+      return detail::caught<Out, C>(ErrorKind::domain_error);
+    } catch(const std::length_error &) {
+      return detail::caught<Out, C>(ErrorKind::length_error);
+    } catch(const std::out_of_range &) {
+      return detail::caught<Out, C>(ErrorKind::out_of_range);
+    } catch(const std::logic_error &) {
+      return detail::caught<Out, C>(ErrorKind::logic_error);
+    } catch(const std::range_error &) {
+      return detail::caught<Out, C>(ErrorKind::range_error);
+    } catch(const std::overflow_error &) {
+      return detail::caught<Out, C>(ErrorKind::overflow_error);
+    } catch(const std::underflow_error &) {
+      return detail::caught<Out, C>(ErrorKind::underflow_error);
+    } catch(const std::runtime_error &) {
+      return detail::caught<Out, C>(ErrorKind::runtime_error);
+    } catch(const std::bad_cast &) {
+      return detail::caught<Out, C>(ErrorKind::bad_cast);
+    } catch(const std::bad_variant_access &) {
+      return detail::caught<Out, C>(ErrorKind::bad_variant_access);
+    } catch(const std::exception &) {
+      return detail::caught<Out, C>(ErrorKind::exception);
+    } catch(...) {
+      return detail::caught<Out, C>(ErrorKind::unknown);
+    }
+  }
+
+  /**
+   * @brief Returns contents of `Ok`, or throws the caught exception (see
+   * `CaughtError::into_exception`) for callers expecting exceptions.
+   */
+  template<typename T>
+  T value_or_rethrow(Result<T, CaughtError> &&result) {
+    if(result.is_err()) result.err_value_.value.rethrow();
+    if constexpr(!std::is_void_v<T>) return std::move(result.ok_value_.value);
+  }
+}  // namespace sundry
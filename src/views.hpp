@@ -0,0 +1,157 @@
+#pragma once
+
+#include "result.hpp"
+
+#include <concepts>
+#include <functional>
+#include <ranges>
+#include <type_traits>
+#include <utility>
+
+namespace sundry {  // namespace sundry
+  /**
+   * @brief Lazy adaptors over ranges of `Result<T, E>`.
+   *
+   * Adaptors are built from the standard ones, hence they compose with
+   * `std::views` and never buffer. Payloads of ranges yielding lvalues are
+   * passed on by reference; payloads of ranges yielding prvalues (e.g. the
+   * output of `transform_ok`) are moved out.
+   */
+  namespace views {
+    namespace detail {
+      /// Returns \p payload as reference if \p R is an lvalue, by value else.
+      template<typename R, typename P>
+      constexpr decltype(auto) forward_payload(P &payload) {
+        if constexpr(std::is_lvalue_reference_v<R>)
+          return (payload);
+        else
+          return std::remove_cvref_t<P>(std::move(payload));
+      }
+
+      /// Forwards Ok payload of \p r.
+      template<ResultType R>
+      constexpr decltype(auto) ok_payload(R &&r) {
+        return forward_payload<R>(r.ok_value_.value);
+      }
+
+      /// Forwards Err payload of \p r.
+      template<ResultType R>
+      constexpr decltype(auto) err_payload(R &&r) {
+        return forward_payload<R>(r.err_value_.value);
+      }
+
+      /// Invokes \p func with Ok payload of \p r, or without arguments if
+      /// the payload is `void`.
+      template<typename F, ResultType R>
+      constexpr decltype(auto) invoke_ok(F &func, R &&r) {
+        if constexpr(std::remove_cvref_t<R>::has_void_ok())
+          return std::invoke(func);
+        else
+          return std::invoke(func, ok_payload<R>(std::forward<R>(r)));
+      }
+
+      /// Builds `Result` of type \p To holding Err of \p r.
+      template<typename To, ResultType R>
+      constexpr To propagate_err(R &&r) {
+        if constexpr(std::remove_cvref_t<R>::has_void_err())
+          return To(in_place_err);
+        else
+          return To(in_place_err, err_payload<R>(std::forward<R>(r)));
+      }
+
+      inline constexpr auto is_ok = [](const ResultType auto &r) {
+        return r.is_ok();
+      };
+
+      inline constexpr auto is_err = [](const ResultType auto &r) {
+        return r.is_err();
+      };
+    }  // namespace detail
+
+    /**
+     * @brief Yields Ok payloads, skipping `Err`s.
+     */
+    inline constexpr auto oks =
+        std::views::filter(detail::is_ok)
+        | std::views::transform([]<ResultType R>(R &&r) -> decltype(auto) {
+            return detail::ok_payload<R>(std::forward<R>(r));
+          });
+
+    /**
+     * @brief Yields Err payloads, skipping `Ok`s.
+     */
+    inline constexpr auto errs =
+        std::views::filter(detail::is_err)
+        | std::views::transform([]<ResultType R>(R &&r) -> decltype(auto) {
+            return detail::err_payload<R>(std::forward<R>(r));
+          });
+
+    /**
+     * @brief Yields `Result`s up to (not including) the first `Err`.
+     */
+    inline constexpr auto take_until_err =
+        std::views::take_while(detail::is_ok);
+
+    /**
+     * @brief Maps Ok payloads with \p func, passing `Err`s through.
+     *
+     * @tparam F callable accepting Ok payload (nothing if it is `void`).
+     * @return adaptor yielding `Result<U, E>`, where `U` is the decayed
+     * return type of \p func.
+     */
+    template<typename F>
+    constexpr auto transform_ok(F func) {
+      return std::views::transform(
+          [func = std::move(func)]<ResultType R>(R &&r) {
+            using Res = std::remove_cvref_t<R>;
+            using U = std::remove_cvref_t<decltype(detail::invoke_ok(
+                func, std::forward<R>(r)))>;
+            using Out = Result<U, typename Res::err_value_t>;
+            if(r.is_err())
+              return detail::propagate_err<Out>(std::forward<R>(r));
+            if constexpr(std::is_void_v<U>) {
+              detail::invoke_ok(func, std::forward<R>(r));
+              return Out(in_place_ok);
+            } else
+              return Out(in_place_ok,
+                         detail::invoke_ok(func, std::forward<R>(r)));
+          });
+    }
+
+    /**
+     * @brief Chains Ok payloads into \p func, which itself returns a `Result`
+     * with the same error type. `Err`s are passed through.
+     *
+     * @tparam F callable accepting Ok payload and returning `Result<U, E>`.
+     */
+    template<typename F>
+    constexpr auto and_then(F func) {
+      return std::views::transform(
+          [func = std::move(func)]<ResultType R>(R &&r) {
+            using Out = std::remove_cvref_t<decltype(detail::invoke_ok(
+                func, std::forward<R>(r)))>;
+            static_assert(ResultType<Out>, "`and_then` callable must return "
+                                           "`Result`");
+            static_assert(std::is_same_v<typename Out::err_value_t,
+                                         typename std::remove_cvref_t<
+                                             R>::err_value_t>,
+                          "`and_then` callable must keep the error type");
+            if(r.is_err())
+              return detail::propagate_err<Out>(std::forward<R>(r));
+            return Out(detail::invoke_ok(func, std::forward<R>(r)));
+          });
+    }
+
+    /**
+     * @brief Drops `Ok`s whose payload does not satisfy \p pred. `Err`s are
+     * kept.
+     */
+    template<typename P>
+    constexpr auto filter_ok(P pred) {
+      return std::views::filter(
+          [pred = std::move(pred)](const ResultType auto &r) {
+            return r.is_err() || detail::invoke_ok(pred, r);
+          });
+    }
+  }  // namespace views
+}  // namespace sundry
@@ -0,0 +1,218 @@
+#include "channel.hpp"
+#include <doctest/doctest.h>
+
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+using namespace sundry;
+
+#define channel_args                                                           \
+  SpscChannel<int, std::string>, SpscChannel<int, std::string, false>,         \
+      MpmcChannel<int, std::string>, MpmcChannel<int, std::string, false>
+
+SCENARIO_TEMPLATE("Channel - single thread", C, channel_args) {
+  GIVEN("channel with capacity 4") {
+    C channel(4);
+    REQUIRE_EQ(channel.capacity(), 4);
+    WHEN("nothing was pushed") {
+      THEN("pop returns nothing and channel is empty") {
+        CHECK_UNARY_FALSE(channel.try_pop().has_value());
+        CHECK_EQ(channel.poll(), ChannelStatus::empty);
+      }
+    }
+    WHEN("Ok and Err values are pushed") {
+      REQUIRE_EQ(channel.try_push(Ok<int> {1}), ChannelStatus::ok);
+      REQUIRE_EQ(channel.try_push(Err<std::string> {"bad"}), ChannelStatus::ok);
+      THEN("they are popped in order") {
+        CHECK_EQ(channel.poll(), ChannelStatus::ok);
+        auto first = channel.try_pop();
+        REQUIRE_UNARY(first.has_value());
+        CHECK_UNARY(first->contains(1));
+        auto second = channel.try_pop();
+        REQUIRE_UNARY(second.has_value());
+        CHECK_UNARY(second->contains_err(std::string("bad")));
+        CHECK_EQ(channel.poll(), ChannelStatus::empty);
+      }
+    }
+    WHEN("channel is filled up") {
+      for(int i = 0; i < 4; ++i)
+        REQUIRE_EQ(channel.try_push(Ok<int> {i}), ChannelStatus::ok);
+      THEN("next push reports `full`") {
+        CHECK_EQ(channel.try_push(Ok<int> {4}), ChannelStatus::full);
+      }
+    }
+    WHEN("batch of values is pushed") {
+      std::vector<Result<int, std::string>> in;
+      for(int i = 0; i < 6; ++i) in.push_back(make_ok<int, std::string>(i));
+      THEN("only capacity values are accepted") {
+        CHECK_EQ(channel.try_push_n(in.begin(), in.size()), 4);
+        AND_THEN("batch pop returns them in order") {
+          std::vector<Result<int, std::string>> out;
+          CHECK_EQ(channel.try_pop_n(std::back_inserter(out), 3), 3);
+          CHECK_EQ(channel.try_pop_n(std::back_inserter(out), 3), 1);
+          REQUIRE_EQ(out.size(), 4);
+          for(int i = 0; i < 4; ++i) CHECK_UNARY(out[i].contains(i));
+        }
+      }
+    }
+    WHEN("channel is closed cleanly") {
+      REQUIRE_EQ(channel.try_push(Ok<int> {1}), ChannelStatus::ok);
+      REQUIRE_UNARY(channel.close());
+      THEN("pushes are rejected") {
+        CHECK_EQ(channel.try_push(Ok<int> {2}), ChannelStatus::closed);
+        CHECK_UNARY_FALSE(channel.close(Err<std::string> {"late"}));
+      }
+      THEN("pending values are still delivered") {
+        CHECK_EQ(channel.poll(), ChannelStatus::ok);
+        CHECK_UNARY(channel.try_pop().has_value());
+        AND_THEN("drained channel reports `closed`") {
+          CHECK_EQ(channel.poll(), ChannelStatus::closed);
+          CHECK_UNARY(channel.close_status().is_ok());
+        }
+      }
+    }
+    WHEN("channel is closed with an error") {
+      REQUIRE_UNARY(channel.close(Err<std::string> {"upstream"}));
+      THEN("drained channel reports `failed` with the error") {
+        CHECK_EQ(channel.poll(), ChannelStatus::failed);
+        auto status = channel.close_status();
+        CHECK_UNARY(status.contains_err(std::string("upstream")));
+      }
+    }
+    WHEN("channel is open") {
+      THEN("`close_status()` throws") {
+        CHECK_THROWS_AS(channel.close_status(), const std::runtime_error &);
+      }
+    }
+  }
+  GIVEN("capacity which is not a power of two") {
+    THEN("constructor throws") {
+      CHECK_THROWS_AS(C(3), const std::invalid_argument &);
+    }
+  }
+}
+
+SCENARIO("Channel - concurrent producers and consumers") {
+  GIVEN("MPMC channel, 4 producers and 4 consumers") {
+    constexpr int producers = 4, consumers = 4, per_producer = 20000;
+    MpmcChannel<int, int> channel(64);
+    std::atomic<long long> sum {0};
+    std::atomic<int> errors {0}, done {0};
+    std::vector<std::thread> threads;
+    for(int p = 0; p < producers; ++p)
+      threads.emplace_back([&] {
+        for(int i = 1; i <= per_producer; ++i)
+          if(i % 100 == 0)
+            channel.push(Err<int> {i});
+          else
+            channel.push(Ok<int> {i});
+        if(++done == producers) channel.close(Err<int> {-1});
+      });
+    for(int c = 0; c < consumers; ++c)
+      threads.emplace_back([&] {
+        std::vector<Result<int, int>> batch;
+        for(;;) {
+          batch.clear();
+          if(channel.try_pop_n(std::back_inserter(batch), 8) == 0) {
+            auto status = channel.poll();
+            if(status == ChannelStatus::failed) break;
+            std::this_thread::yield();
+            continue;
+          }
+          for(auto &r : batch)
+            if(r.is_ok())
+              sum += r.unwrap();
+            else
+              ++errors;
+        }
+      });
+    for(auto &t : threads) t.join();
+    THEN("every value is delivered exactly once") {
+      long long expected = 0;
+      for(int i = 1; i <= per_producer; ++i)
+        if(i % 100) expected += i;
+      CHECK_EQ(sum.load(), expected * producers);
+      CHECK_EQ(errors.load(), producers * per_producer / 100);
+      CHECK_UNARY(channel.close_status().contains_err(-1));
+    }
+  }
+  GIVEN("SPSC channel") {
+    constexpr int count = 100000;
+    SpscChannel<int, int, false> channel(16);
+    long long sum = 0;
+    std::thread producer([&] {
+      for(int i = 0; i < count; ++i) channel.push(Ok<int> {i});
+      channel.close();
+    });
+    for(;;) {
+      auto r = channel.try_pop();
+      if(r) {
+        sum += r->unwrap();
+        continue;
+      }
+      if(channel.poll() == ChannelStatus::closed) break;
+    }
+    producer.join();
+    THEN("every value is delivered") {
+      CHECK_EQ(sum, (long long) count * (count - 1) / 2);
+    }
+  }
+}
+
+namespace {
+  /// Payload whose copies throw for negative values; moves never throw.
+  struct Fragile {
+    int value;
+
+    explicit Fragile(int v) : value(v) {}
+    Fragile(const Fragile &other) : value(other.value) {
+      if(value < 0) throw std::runtime_error("copy of negative Fragile");
+    }
+    Fragile(Fragile &&) noexcept = default;
+  };
+}  // namespace
+
+#define fragile_channel_args                                                   \
+  SpscChannel<Fragile, int>, MpmcChannel<Fragile, int>
+
+SCENARIO_TEMPLATE("Channel - throwing conversions", C, fragile_channel_args) {
+  GIVEN("channel with capacity 4") {
+    C channel(4);
+    WHEN("a single push throws") {
+      const Ok<Fragile> bad {Fragile(-1)};
+      CHECK_THROWS_AS(channel.try_push(bad), std::runtime_error);
+      THEN("channel stays usable") {
+        CHECK_UNARY_FALSE(channel.try_pop().has_value());
+        REQUIRE_EQ(channel.try_push(Ok<Fragile> {Fragile(5)}),
+                   ChannelStatus::ok);
+        auto popped = channel.try_pop();
+        REQUIRE_UNARY(popped.has_value());
+        CHECK_EQ(popped->ok_value_.value.value, 5);
+        CHECK_EQ(channel.poll(), ChannelStatus::empty);
+      }
+    }
+    WHEN("a batch push throws in the middle") {
+      std::vector<Ok<Fragile>> batch;
+      for(int v : {1, -1, 3}) batch.push_back(Ok<Fragile> {Fragile(v)});
+      // Const elements are copied, which throws for the second one.
+      auto first = std::as_const(batch).begin();
+      CHECK_THROWS_AS(channel.try_push_n(first, batch.size()),
+                      std::runtime_error);
+      THEN("values before the failure are delivered and nothing blocks") {
+        std::vector<Result<Fragile, int>> out;
+        CHECK_EQ(channel.try_pop_n(std::back_inserter(out), 4), 1);
+        REQUIRE_EQ(out.size(), 1);
+        CHECK_EQ(out[0].ok_value_.value.value, 1);
+        CHECK_EQ(channel.try_pop_n(std::back_inserter(out), 4), 0);
+        CHECK_EQ(channel.poll(), ChannelStatus::empty);
+        for(int i = 0; i < 4; ++i)
+          REQUIRE_EQ(channel.try_push(Ok<Fragile> {Fragile(i)}),
+                     ChannelStatus::ok);
+      }
+    }
+  }
+}
@@ -0,0 +1,234 @@
+#include "error_log.hpp"
+#include <doctest/doctest.h>
+
+#include <algorithm>
+#include <atomic>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+using namespace sundry;
+
+namespace {
+  /// Lines handed to the writer; read only after `flush` or `stop`.
+  struct Captured {
+    std::string text;
+
+    ErrorLog::Writer writer() {
+      return [this](std::string_view chunk) { text += chunk; };
+    }
+
+    std::size_t lines() const {
+      return std::count(text.begin(), text.end(), '\n');
+    }
+  };
+
+  /// Trivially copyable error without default constructor.
+  struct Code {
+    explicit Code(int v) : value(v) {}
+    int value;
+  };
+
+  std::ostream &operator<<(std::ostream &os, const Code &code) {
+    return os << "code " << code.value;
+  }
+}  // namespace
+
+SCENARIO("ErrorLog - formatting") {
+  GIVEN("a log") {
+    Captured out;
+    ErrorLog log(out.writer());
+    WHEN("results are logged") {
+      Result<int, int> ok(in_place_ok, 1), err(in_place_err, 404);
+      ok.log_if_err(log);
+      err.log_if_err(log);
+      auto line = std::source_location::current().line() - 1;
+      log.flush();
+      THEN("only Err is written, with its call site") {
+        REQUIRE_EQ(out.lines(), 1);
+        auto site = "error_log.cpp:" + std::to_string(line) + ' ';
+        CHECK_NE(out.text.find(site), std::string::npos);
+        CHECK_NE(out.text.find(": Err(404)\n"), std::string::npos);
+        CHECK_EQ(log.stats().written, 1);
+      }
+    }
+    WHEN("string and void errors are logged") {
+      auto result = Result<int, std::string>(in_place_err, "bad input")
+                        .log_if_err(log);
+      Result<int, void>(in_place_err).log_if_err(log);
+      log.log(Err<std::string> {std::string(200, 'x')});
+      log.flush();
+      THEN("their payloads are written, long strings truncated") {
+        CHECK_UNARY(result.contains_err(std::string("bad input")));
+        REQUIRE_EQ(out.lines(), 3);
+        CHECK_NE(out.text.find(": Err(bad input)\n"), std::string::npos);
+        CHECK_NE(out.text.find(": Err()\n"), std::string::npos);
+        auto kept = "Err(" + std::string(detail::log_payload_size, 'x') + ")";
+        CHECK_NE(out.text.find(kept + '\n'), std::string::npos);
+      }
+    }
+    WHEN("an error without default constructor is logged") {
+      log.log(Err<Code> {Code(7)});
+      log.flush();
+      THEN("it is copied back out of the record") {
+        CHECK_NE(out.text.find(": Err(code 7)\n"), std::string::npos);
+      }
+    }
+  }
+}
+
+SCENARIO("ErrorLog - overflow and rate limiting") {
+  GIVEN("a log whose writer is stalled") {
+    std::atomic<bool> entered {false}, release {false};
+    std::size_t lines = 0;
+    ErrorLogOptions options;
+    options.capacity = 4;
+    ErrorLog log(
+        [&](std::string_view chunk) {
+          entered = true;
+          while(!release) std::this_thread::yield();
+          lines += std::count(chunk.begin(), chunk.end(), '\n');
+        },
+        options);
+    log.log(Err<int> {0});
+    while(!entered) std::this_thread::yield();
+    WHEN("more records than fit are logged") {
+      int queued = 0;
+      for(int i = 1; i <= 6; ++i) queued += log.log(Err<int> {i});
+      release = true;
+      log.flush();
+      THEN("excess records are dropped and counted") {
+        CHECK_EQ(queued, 4);
+        CHECK_EQ(lines, 5);
+        auto stats = log.stats();
+        CHECK_EQ(stats.written, 5);
+        CHECK_EQ(stats.dropped, 2);
+      }
+    }
+  }
+  GIVEN("a log limited to one record per second with burst of 3") {
+    Captured out;
+    ErrorLogOptions options;
+    options.rate = 1;
+    options.burst = 3;
+    ErrorLog log(out.writer(), options);
+    WHEN("a burst of records is logged") {
+      for(int i = 0; i < 10; ++i) log.log(Err<int> {i});
+      log.flush();
+      THEN("only the burst is written") {
+        CHECK_EQ(out.lines(), 3);
+        CHECK_EQ(log.stats().limited, 7);
+      }
+    }
+  }
+  GIVEN("a stopped log") {
+    Captured out;
+    ErrorLog log(out.writer());
+    log.log(Err<int> {1});
+    log.stop();
+    THEN("earlier records are written and later ones dropped") {
+      CHECK_EQ(out.lines(), 1);
+      CHECK_UNARY_FALSE(log.log(Err<int> {2}));
+      CHECK_EQ(log.stats().dropped, 1);
+    }
+  }
+  GIVEN("an invalid capacity") {
+    ErrorLogOptions options;
+    options.capacity = 3;
+    THEN("construction throws") {
+      CHECK_THROWS_AS(ErrorLog([](std::string_view) {}, options),
+                      std::invalid_argument);
+    }
+  }
+  GIVEN("rates around one record per nanosecond") {
+    ErrorLogOptions options;
+    options.rate = max_log_rate;
+    THEN("the maximum is accepted and anything above rejected") {
+      CHECK_NOTHROW(ErrorLog([](std::string_view) {}, options));
+      options.rate = max_log_rate + 1;
+      CHECK_THROWS_AS(ErrorLog([](std::string_view) {}, options),
+                      std::invalid_argument);
+    }
+  }
+}
+
+SCENARIO("ErrorLog - many threads") {
+  GIVEN("a blocking log and several logging threads") {
+    Captured out;
+    ErrorLogOptions options;
+    options.capacity = 16;
+    options.overflow = Overflow::block;
+    ErrorLog log(out.writer(), options);
+    constexpr int threads = 4, per_thread = 1000;
+    std::vector<std::thread> workers;
+    for(int t = 0; t < threads; ++t)
+      workers.emplace_back([&, t] {
+        for(int i = 0; i < per_thread; ++i)
+          Result<int, int>(in_place_err, t * per_thread + i).log_if_err(log);
+      });
+    for(auto &worker : workers) worker.join();
+    log.flush();
+    THEN("every record is written, each thread's in order") {
+      REQUIRE_EQ(out.lines(), threads * per_thread);
+      CHECK_EQ(log.stats().dropped, 0);
+      std::vector<int> last(threads, -1);
+      for(std::size_t at = 0; (at = out.text.find("Err(", at)) != out.text.npos;
+          ++at) {
+        int value = std::stoi(out.text.substr(at + 4));
+        auto &previous = last[value / per_thread];
+        CHECK_LT(previous, value);
+        previous = value;
+      }
+      for(int t = 0; t < threads; ++t)
+        CHECK_EQ(last[t], t * per_thread + per_thread - 1);
+    }
+  }
+  GIVEN("a rate limited log and many short-lived threads") {
+    Captured out;
+    ErrorLogOptions options;
+    options.capacity = 4;
+    options.rate = 1;
+    options.burst = 1;
+    ErrorLog log(out.writer(), options);
+    constexpr int threads = 64;
+    for(int t = 0; t < threads; ++t)
+      std::thread([&] {
+        log.log(Err<int> {1});
+        log.log(Err<int> {2});
+      }).join();
+    log.flush();
+    THEN("rings of exited threads are freed, their counters kept") {
+      auto stats = log.stats();
+      CHECK_EQ(stats.threads, 0);
+      CHECK_EQ(stats.written, threads);
+      CHECK_EQ(stats.limited, threads);
+      CHECK_EQ(out.lines(), threads);
+    }
+  }
+  GIVEN("a thread outliving the log it logged to") {
+    std::atomic<bool> logged {false}, destroyed {false};
+    std::size_t lines = 0, registered = 0;
+    std::thread worker;
+    {
+      Captured out;
+      ErrorLog log(out.writer());
+      worker = std::thread([&] {
+        log.log(Err<int> {1});
+        logged = true;
+        while(!destroyed) std::this_thread::yield();
+      });
+      while(!logged) std::this_thread::yield();
+      log.flush();
+      lines = out.lines();
+      registered = log.stats().threads;
+    }
+    destroyed = true;
+    worker.join();
+    THEN("the thread still owns its ring until it exits") {
+      CHECK_EQ(lines, 1);
+      CHECK_EQ(registered, 1);
+    }
+  }
+}
@@ -0,0 +1,106 @@
+#include "result.hpp"
+#include <doctest/doctest.h>
+
+#include <array>
+#include <ostream>
+#include <string>
+#include <vector>
+
+using namespace sundry;
+
+namespace {
+  struct Point {
+    int x, y;
+  };
+
+  std::ostream &operator<<(std::ostream &os, const Point &p) {
+    return os << '(' << p.x << ", " << p.y << ')';
+  }
+
+  template<typename V>
+  std::string formatted(const V &value) {
+    std::string out;
+    sundry::format_to(std::back_inserter(out), value);
+    return out;
+  }
+}  // namespace
+
+SCENARIO("format_to") {
+  GIVEN("arithmetic payloads") {
+    THEN("they are written via `to_chars`") {
+      CHECK_EQ(formatted(Ok<int> {-42}), "Ok(-42)");
+      CHECK_EQ(formatted(Err<unsigned> {7}), "Err(7)");
+      CHECK_EQ(formatted(Ok<double> {0.5}), "Ok(0.5)");
+      CHECK_EQ(formatted(Ok<bool> {true}), "Ok(true)");
+      CHECK_EQ(formatted(Err<char> {'x'}), "Err(x)");
+    }
+  }
+  GIVEN("string-like and streamable payloads") {
+    THEN("they are copied or streamed") {
+      CHECK_EQ(formatted(Err<std::string> {"bad"}), "Err(bad)");
+      CHECK_EQ(formatted(Ok<const char *> {"hi"}), "Ok(hi)");
+      Ok<Point> point {{1, 2}};
+      CHECK_EQ(formatted(point), "Ok((1, 2))");
+    }
+  }
+  GIVEN("void payloads") {
+    THEN("parentheses are empty") {
+      CHECK_EQ(formatted(Ok<void> {}), "Ok()");
+      CHECK_EQ(formatted(Err<void> {}), "Err()");
+    }
+  }
+  GIVEN("a Result") {
+    THEN("held alternative is written") {
+      Result<int, std::string> ok {Ok<int> {3}};
+      Result<int, std::string> err {Err<std::string> {"e"}};
+      Result<void, int> void_ok {Ok<void> {}};
+      CHECK_EQ(formatted(ok), "Ok(3)");
+      CHECK_EQ(formatted(err), "Err(e)");
+      CHECK_EQ(formatted(void_ok), "Ok()");
+    }
+  }
+}
+
+SCENARIO("format_into") {
+  GIVEN("a buffer large enough") {
+    std::array<char, 16> buffer {};
+    WHEN("a Result is formatted") {
+      Result<int, int> value {Err<int> {123}};
+      auto written = format_into(buffer, value);
+      THEN("number of written characters is returned") {
+        REQUIRE_UNARY(written.contains(8));
+        CHECK_EQ(std::string(buffer.data(), 8), "Err(123)");
+      }
+    }
+  }
+  GIVEN("a buffer too small") {
+    std::array<char, 4> buffer {};
+    WHEN("a Result is formatted") {
+      auto written = format_into(buffer, Ok<long> {123456});
+      THEN("required size is returned and output is truncated") {
+        CHECK_UNARY(written.contains_err(10));
+        CHECK_EQ(std::string(buffer.data(), 4), "Ok(1");
+      }
+    }
+  }
+}
+
+SCENARIO("Result - unwrap messages") {
+  GIVEN("an Err with arithmetic payload") {
+    Result<int, double> value {Err<double> {1.5}};
+    THEN("unwrap message holds the payload") {
+      CHECK_THROWS_WITH_AS(value.unwrap(),
+                           "called `Result::unwrap()` on `Err` value 1.5\n",
+                           const std::runtime_error &);
+    }
+  }
+  GIVEN("an Ok with streamable payload") {
+    Result<Point, int> value {Ok<Point> {{3, 4}}};
+    THEN("unwrap_err message holds the payload") {
+      CHECK_THROWS_WITH_AS(
+          value.unwrap_err(),
+          "called `Result::unwrap_err()` on `Ok` value (3, 4)\n",
+          const std::runtime_error &);
+    }
+  }
+}
@@ -0,0 +1,112 @@
+#include "interop.hpp"
+#include <doctest/doctest.h>
+
+#include <memory>
+#include <optional>
+#include <string>
+#include <variant>
+
+using namespace sundry;
+
+namespace {
+  /// Counts copies and moves of all instances.
+  struct Tracked {
+    static inline int copies = 0;
+    static inline int moves = 0;
+
+    int value;
+
+    explicit Tracked(int v) : value(v) {}
+    Tracked(const Tracked &other) : value(other.value) { ++copies; }
+    Tracked(Tracked &&other) noexcept : value(other.value) { ++moves; }
+
+    static void reset() { copies = moves = 0; }
+  };
+}  // namespace
+
+SCENARIO("interop - std::optional") {
+  GIVEN("a Result holding a move-only value") {
+    Result<std::unique_ptr<int>, int> value(in_place_ok,
+                                            std::make_unique<int>(5));
+    WHEN("it is converted with `ok() &&`") {
+      auto ok = std::move(value).ok();
+      THEN("the payload is moved out") {
+        REQUIRE_UNARY(ok.has_value());
+        CHECK_EQ(**ok, 5);
+      }
+    }
+  }
+  GIVEN("a Result holding a tracked value") {
+    Result<Tracked, Tracked> value(in_place_err, 3);
+    Tracked::reset();
+    THEN("`err_ptr()` refers to the payload without copying") {
+      REQUIRE_NE(value.err_ptr(), nullptr);
+      CHECK_EQ(value.err_ptr()->value, 3);
+      CHECK_EQ(value.ok_ptr(), nullptr);
+      CHECK_EQ(Tracked::copies + Tracked::moves, 0);
+    }
+    THEN("`err() &&` moves and `err() const &` copies") {
+      auto moved = std::move(value).err();
+      CHECK_EQ(Tracked::copies, 0);
+      CHECK_EQ(Tracked::moves, 1);
+      CHECK_EQ(moved->value, 3);
+      auto copied = value.err();
+      CHECK_EQ(Tracked::copies, 1);
+      REQUIRE_UNARY(copied.has_value());
+      CHECK_EQ(copied->value, 3);
+    }
+  }
+  GIVEN("optionals") {
+    std::optional<std::string> some("text"), none;
+    THEN("they become Ok or the given Err") {
+      CHECK_UNARY(from_optional(some).contains("text"));
+      CHECK_UNARY(from_optional(none).is_err());
+      CHECK_UNARY(from_optional(none, Err<int> {7}).contains_err(7));
+      auto moved = from_optional(std::move(some));
+      CHECK_UNARY(moved.contains("text"));
+    }
+  }
+}
+
+SCENARIO("interop - std::variant") {
+  GIVEN("trivially copyable payloads") {
+    THEN("variant has the layout size of Result") {
+      CHECK_EQ(sizeof(std::variant<Ok<long>, Err<int>>),
+               sizeof(Result<long, int>));
+    }
+  }
+  GIVEN("Results with equal payload types") {
+    Result<int, int> ok(in_place_ok, 1), err(in_place_err, 1);
+    WHEN("they are converted to variants") {
+      auto ok_variant = to_variant(ok);
+      auto err_variant = to_variant(err);
+      THEN("Ok and Err stay distinguishable") {
+        CHECK_EQ(ok_variant.index(), 0);
+        CHECK_EQ(err_variant.index(), 1);
+        CHECK_UNARY(from_variant(ok_variant).contains(1));
+        CHECK_UNARY(from_variant(err_variant).contains_err(1));
+      }
+    }
+  }
+  GIVEN("a Result with void payloads") {
+    Result<void, void> value(in_place_err);
+    THEN("it maps to `Ok<void>`/`Err<void>` alternatives") {
+      auto variant = to_variant(value);
+      CHECK_UNARY(std::holds_alternative<Err<void>>(variant));
+      CHECK_UNARY(from_variant(variant).is_err());
+      CHECK_UNARY(from_variant(to_variant(Result<void, void>(in_place_ok)))
+                      .is_ok());
+    }
+  }
+  GIVEN("a Result holding a tracked value") {
+    Result<Tracked, int> value(in_place_ok, 4);
+    Tracked::reset();
+    WHEN("it is moved through a variant and back") {
+      auto back = from_variant(to_variant(std::move(value)));
+      THEN("the payload is never copied") {
+        CHECK_EQ(Tracked::copies, 0);
+        CHECK_EQ(back.ok_value_.value.value, 4);
+      }
+    }
+  }
+}
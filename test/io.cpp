@@ -0,0 +1,137 @@
+#include "io.hpp"
+#include <doctest/doctest.h>
+
+#include <array>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <string_view>
+
+using namespace sundry;
+using namespace sundry::io;
+
+namespace {
+  /// Temporary file removed on scope exit.
+  struct TempFile {
+    std::string path = "/tmp/sundry_io_XXXXXX";
+
+    explicit TempFile(std::string_view contents) {
+      int fd = ::mkstemp(path.data());
+      REQUIRE_GE(fd, 0);
+      REQUIRE_EQ(::write(fd, contents.data(), contents.size()),
+                 (ssize_t) contents.size());
+      ::close(fd);
+    }
+
+    ~TempFile() { ::unlink(path.c_str()); }
+  };
+
+  std::string_view text(std::span<const std::byte> bytes) {
+    return {reinterpret_cast<const char *>(bytes.data()), bytes.size()};
+  }
+
+  std::span<const std::byte> bytes(std::string_view text) {
+    return std::as_bytes(std::span(text.data(), text.size()));
+  }
+}  // namespace
+
+SCENARIO("io - reading and writing") {
+  GIVEN("file with known contents") {
+    TempFile tmp("hello, world");
+    auto file = io::open(tmp.path.c_str()).unwrap();
+    std::array<std::byte, 64> buffer;
+    WHEN("`read` is called") {
+      auto r = io::read(file, buffer);
+      THEN("filled prefix of the buffer is returned") {
+        REQUIRE_UNARY(r.is_ok());
+        CHECK_EQ(r.ok_value_.value.data(), buffer.data());
+        CHECK_EQ(text(r.ok_value_.value), "hello, world");
+        AND_THEN("next read reports end of file") {
+          CHECK_UNARY(io::read(file, buffer).unwrap().empty());
+        }
+      }
+    }
+    WHEN("`pread` is called with an offset") {
+      auto r = io::pread(file, std::span(buffer).first(5), 7);
+      THEN("requested range is returned") {
+        CHECK_EQ(text(r.unwrap()), "world");
+      }
+    }
+    WHEN("`readv`/`preadv` are called") {
+      std::array<std::byte, 5> a;
+      std::array<std::byte, 2> b;
+      std::array<iovec, 2> iov {io::buffer(a), io::buffer(b)};
+      THEN("buffers are filled in order") {
+        CHECK_UNARY(io::readv(file, iov).contains(7));
+        CHECK_EQ(text(a), "hello");
+        CHECK_EQ(text(b), ", ");
+        CHECK_UNARY(io::preadv(file, iov, 7).contains(5));
+        CHECK_EQ(text(a), "world");
+      }
+    }
+    WHEN("file is opened for writing") {
+      auto out = io::open(tmp.path.c_str(), O_WRONLY | O_TRUNC).unwrap();
+      REQUIRE_UNARY(io::write(out, bytes("abc")).contains(3));
+      REQUIRE_UNARY(io::pwrite(out, bytes("Z"), 1).contains(1));
+      THEN("written bytes can be read back") {
+        CHECK_EQ(text(io::read(file, buffer).unwrap()), "aZc");
+      }
+      THEN("closing reports success") {
+        CHECK_UNARY(out.close().is_ok());
+        CHECK_UNARY_FALSE(out.is_open());
+      }
+    }
+  }
+  GIVEN("path which does not exist") {
+    WHEN("it is opened") {
+      auto r = io::open("/nonexistent/sundry/file");
+      THEN("`ENOENT` is returned") {
+        CHECK_UNARY(r.contains_err(Errno {ENOENT}));
+      }
+    }
+  }
+  GIVEN("file opened for reading only") {
+    TempFile tmp("x");
+    auto file = io::open(tmp.path.c_str()).unwrap();
+    WHEN("it is written to") {
+      THEN("`EBADF` is returned") {
+        CHECK_UNARY(io::write(file, bytes("y")).contains_err(Errno {EBADF}));
+      }
+    }
+  }
+}
+
+SCENARIO("io - memory mapping") {
+  GIVEN("file with known contents") {
+    TempFile tmp("mapped contents");
+    WHEN("it is mapped") {
+      auto mapped = MappedFile::open(tmp.path.c_str()).unwrap();
+      THEN("contents are visible without copying") {
+        CHECK_EQ(mapped.size(), 15);
+        CHECK_EQ(text(mapped.bytes()), "mapped contents");
+        CHECK_UNARY(mapped.advise(MADV_SEQUENTIAL).is_ok());
+      }
+      AND_WHEN("mapping is moved") {
+        auto other = std::move(mapped);
+        THEN("ownership is transferred") {
+          CHECK_UNARY(mapped.bytes().empty());
+          CHECK_EQ(text(other.bytes()), "mapped contents");
+        }
+      }
+    }
+  }
+  GIVEN("empty file") {
+    TempFile tmp("");
+    THEN("mapping is empty") {
+      auto mapped = MappedFile::open(tmp.path.c_str());
+      REQUIRE_UNARY(mapped.is_ok());
+      CHECK_UNARY(mapped.ok_value_.value.bytes().empty());
+    }
+  }
+  GIVEN("path which does not exist") {
+    THEN("`ENOENT` is returned") {
+      CHECK_UNARY(MappedFile::open("/nonexistent/sundry/file")
+                      .contains_err(Errno {ENOENT}));
+    }
+  }
+}
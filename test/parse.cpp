@@ -0,0 +1,174 @@
+#include "parse.hpp"
+#include <doctest/doctest.h>
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <limits>
+#include <string>
+
+using namespace sundry;
+using namespace sundry::parse;
+using namespace std::chrono_literals;
+
+namespace {
+  enum class Level { debug, info, error };
+
+  constexpr std::array<std::pair<std::string_view, Level>, 3> level_names {
+      {{"debug", Level::debug}, {"info", Level::info}, {"error", Level::error}}};
+}  // namespace
+
+SCENARIO("parse::number") {
+  GIVEN("integral target types") {
+    THEN("short and long digit runs are parsed") {
+      CHECK_UNARY(number<int>("0").contains(0));
+      CHECK_UNARY(number<int>("-42").contains(-42));
+      CHECK_UNARY(number<int>("123456789").contains(123456789));
+      CHECK_UNARY(number<int>("2147483647").contains(2147483647));
+      CHECK_UNARY(number<std::int64_t>("-1234567890123456789")
+                      .contains(-1234567890123456789));
+      CHECK_UNARY(number<std::uint64_t>("18446744073709551615")
+                      .contains(18446744073709551615ull));
+      CHECK_UNARY(number<std::uint8_t>("255").contains(255));
+    }
+    THEN("negative values of every width keep their sign") {
+      CHECK_UNARY(number<std::int8_t>("-128").contains(-128));
+      CHECK_UNARY(number<long long>("-5").contains(-5));
+      CHECK_UNARY(number<long long>("-9223372036854775808")
+                      .contains(std::numeric_limits<long long>::min()));
+    }
+    THEN("leading zeros beyond type width are accepted") {
+      CHECK_UNARY(number<short>("0000000000000000000000012").contains(12));
+    }
+    THEN("errors carry reason and position") {
+      CHECK_UNARY(number<int>("").contains_err(ParseError {ParseErrc::empty, 0}));
+      CHECK_UNARY(
+          number<int>("abc").contains_err(ParseError {ParseErrc::invalid, 0}));
+      CHECK_UNARY(
+          number<int>("-").contains_err(ParseError {ParseErrc::invalid, 1}));
+      CHECK_UNARY(
+          number<int>("12x4").contains_err(ParseError {ParseErrc::trailing, 2}));
+      CHECK_UNARY(number<unsigned>("-1").contains_err(
+          ParseError {ParseErrc::invalid, 0}));
+      CHECK_UNARY(number<int>("2147483648")
+                      .contains_err(ParseError {ParseErrc::out_of_range, 0}));
+      CHECK_UNARY(number<std::uint8_t>("256").contains_err(
+          ParseError {ParseErrc::out_of_range, 0}));
+    }
+    THEN("digit runs longer than a vector register are validated") {
+      CHECK_UNARY(number<std::uint64_t>("00000000000000000000000000000000001")
+                      .contains(1));
+      CHECK_UNARY(number<std::uint64_t>("0000000000000000000000000000000x01")
+                      .contains_err(ParseError {ParseErrc::trailing, 31}));
+    }
+#if defined(__SIZEOF_INT128__) && !defined(__STRICT_ANSI__)
+    THEN("128-bit values beyond 64-bit range are parsed exactly") {
+      __int128 twenty = 9999999999;
+      twenty = twenty * 10000000000 + 9999999999;
+      __int128 thirty = 1234567890123456789;
+      thirty = thirty * 100000000000 + 1234567890;
+      CHECK_UNARY(number<__int128>("99999999999999999999").contains(twenty));
+      CHECK_UNARY(number<__int128>("-123456789012345678901234567890")
+                      .contains(-thirty));
+    }
+    THEN("short negative 128-bit values are negated in 128 bits") {
+      __int128 min64 = std::numeric_limits<long long>::min();
+      CHECK_UNARY(number<__int128>("-5").contains(-5));
+      CHECK_UNARY(number<__int128>("-9223372036854775808").contains(min64));
+      auto out = column<__int128>("-5,7,", ',');
+      REQUIRE_EQ(out.values.size(), 2);
+      CHECK_UNARY(out.values[0] == -5);
+      CHECK_UNARY(out.values[1] == 7);
+    }
+#endif
+  }
+  GIVEN("floating point target types") {
+    THEN("values are parsed") {
+      CHECK_UNARY(number<double>("2.5").contains(2.5));
+      CHECK_UNARY(number<double>("-1e3").contains(-1000.0));
+      CHECK_UNARY(number<float>("0.25").contains(0.25f));
+    }
+    THEN("errors carry reason and position") {
+      CHECK_UNARY(
+          number<double>("x").contains_err(ParseError {ParseErrc::invalid, 0}));
+      CHECK_UNARY(number<double>("1.5kg").contains_err(
+          ParseError {ParseErrc::trailing, 3}));
+      CHECK_UNARY(number<float>("1e99").contains_err(
+          ParseError {ParseErrc::out_of_range, 0}));
+    }
+  }
+  GIVEN("failed parse") {
+    THEN("`unwrap()` reports the error") {
+      CHECK_THROWS_WITH_AS(number<int>("1x").unwrap(),
+                           "called `Result::unwrap()` on `Err` value "
+                           "trailing characters at 1\n",
+                           const std::runtime_error &);
+    }
+  }
+}
+
+SCENARIO("parse::boolean, parse::duration, parse::enumeration") {
+  GIVEN("boolean literals") {
+    THEN("they are parsed") {
+      CHECK_UNARY(boolean("true").contains(true));
+      CHECK_UNARY(boolean("0").contains(false));
+      CHECK_UNARY(boolean("yes").contains_err(ParseError {ParseErrc::invalid, 0}));
+    }
+  }
+  GIVEN("durations") {
+    THEN("single and compound values are parsed") {
+      CHECK_UNARY(duration("250ms").contains(250ms));
+      CHECK_UNARY(duration("1h30m").contains(90min));
+      CHECK_UNARY(duration("10s5ns").contains(10s + 5ns));
+    }
+    THEN("errors carry reason and position") {
+      CHECK_UNARY(duration("").contains_err(ParseError {ParseErrc::empty, 0}));
+      CHECK_UNARY(
+          duration("5").contains_err(ParseError {ParseErrc::invalid, 1}));
+      CHECK_UNARY(
+          duration("1h5d").contains_err(ParseError {ParseErrc::invalid, 3}));
+      CHECK_UNARY(
+          duration("1hm").contains_err(ParseError {ParseErrc::invalid, 1}));
+      CHECK_UNARY(duration("9999999h").contains_err(
+          ParseError {ParseErrc::out_of_range, 0}));
+    }
+  }
+  GIVEN("enumerator names") {
+    THEN("they are looked up") {
+      CHECK_UNARY(enumeration("info", level_names).contains(Level::info));
+      CHECK_UNARY(enumeration("warn", level_names)
+                      .contains_err(ParseError {ParseErrc::invalid, 0}));
+    }
+  }
+}
+
+SCENARIO("parse::column") {
+  GIVEN("delimited buffer of integers") {
+    std::string buffer = "1,-2,,x3,12345678901234567,99999999999,7,";
+    WHEN("it is parsed into a column") {
+      auto out = column<std::int32_t>(buffer, ',');
+      THEN("values and errors are split") {
+        REQUIRE_EQ(out.values.size(), 7);
+        CHECK_EQ(out.values[0], 1);
+        CHECK_EQ(out.values[1], -2);
+        CHECK_EQ(out.values[6], 7);
+        REQUIRE_EQ(out.failed.size(), 4);
+        CHECK_EQ(out.failed[0], 2);
+        CHECK_UNARY(out.errors[0] == ParseError {ParseErrc::empty, 0});
+        CHECK_EQ(out.failed[1], 3);
+        CHECK_UNARY(out.errors[1] == ParseError {ParseErrc::invalid, 0});
+        CHECK_EQ(out.failed[2], 4);
+        CHECK_UNARY(out.errors[2] == ParseError {ParseErrc::out_of_range, 0});
+        CHECK_EQ(out.failed[3], 5);
+      }
+    }
+  }
+  GIVEN("newline separated floats") {
+    auto out = column<double>("0.5\n1.5\n", '\n');
+    THEN("they are parsed") {
+      REQUIRE_EQ(out.values.size(), 2);
+      CHECK_EQ(out.values[1], 1.5);
+      CHECK_UNARY(out.failed.empty());
+    }
+  }
+}
@@ -0,0 +1,203 @@
+#include "serialize.hpp"
+#include <doctest/doctest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include <ranges>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using namespace sundry;
+using namespace sundry::serialize;
+
+namespace {
+  struct Point {
+    std::int32_t x, y;
+
+    bool operator==(const Point &) const = default;
+  };
+
+  template<typename T, typename E>
+  std::vector<std::byte> encoded(const Result<T, E> &value) {
+    std::vector<std::byte> out;
+    encode(value, out);
+    return out;
+  }
+
+  std::vector<std::byte> bytes(std::initializer_list<int> values) {
+    std::vector<std::byte> out;
+    for(int v : values) out.push_back(std::byte(v));
+    return out;
+  }
+
+  static_assert(std::ranges::forward_range<BatchView<std::string, int>>);
+}  // namespace
+
+SCENARIO_TEMPLATE("serialize - round trip of fixed size payloads", T,
+                  std::int8_t, int, double, Point) {
+  GIVEN("Ok and Err values") {
+    Result<T, std::uint16_t> ok(in_place_ok, T {});
+    Result<T, std::uint16_t> err(in_place_err, std::uint16_t {404});
+    THEN("records are a tag byte followed by payload bytes") {
+      auto ok_bytes = encoded(ok), err_bytes = encoded(err);
+      CHECK_EQ(ok_bytes.size(), 1 + sizeof(T));
+      CHECK_EQ(err_bytes.size(), 1 + sizeof(std::uint16_t));
+      CHECK_EQ(ok_bytes[0], std::byte {1});
+      CHECK_EQ(err_bytes[0], std::byte {0});
+      CHECK_EQ(encoded_size(ok), ok_bytes.size());
+    }
+    THEN("they are decoded back") {
+      auto ok_back = decode<T, std::uint16_t>(encoded(ok));
+      auto err_back = decode<T, std::uint16_t>(encoded(err));
+      REQUIRE_UNARY(ok_back.is_ok());
+      REQUIRE_UNARY(err_back.is_ok());
+      CHECK_UNARY(ok_back.ok_value_.value.contains(T {}));
+      CHECK_UNARY(err_back.ok_value_.value.contains_err(404));
+    }
+  }
+}
+
+SCENARIO("serialize - string and void payloads") {
+  GIVEN("a Result holding a string") {
+    Result<std::string, void> value(in_place_ok, "payload");
+    auto buffer = encoded(value);
+    THEN("it is length-prefixed") {
+      CHECK_EQ(buffer.size(), 1 + 4 + 7);
+    }
+    WHEN("it is viewed") {
+      auto viewed = view<std::string, void>(buffer);
+      THEN("payload refers to the buffer") {
+        REQUIRE_UNARY(viewed.is_ok());
+        auto text = viewed.ok_value_.value.ok_value_.value;
+        CHECK_EQ(text, "payload");
+        CHECK_EQ(static_cast<const void *>(text.data()),
+                 static_cast<const void *>(buffer.data() + 5));
+      }
+    }
+  }
+  GIVEN("void payloads") {
+    Result<void, void> ok(in_place_ok), err(in_place_err);
+    THEN("records hold the tag only") {
+      CHECK_EQ(encoded(ok), bytes({1}));
+      CHECK_EQ(encoded(err), bytes({0}));
+      CHECK_UNARY(decode<void, void>(encoded(err)).ok_value_.value.is_err());
+    }
+  }
+}
+
+SCENARIO("serialize - malformed input") {
+  GIVEN("an empty buffer") {
+    THEN("it is truncated") {
+      auto expected = DecodeError {DecodeErrc::truncated, 0};
+      CHECK_UNARY(decode<int, int>({}).contains_err(expected));
+    }
+  }
+  GIVEN("a record cut short") {
+    auto buffer = encoded(Result<int, int>(in_place_ok, 7));
+    buffer.pop_back();
+    THEN("it is truncated") {
+      auto expected = DecodeError {DecodeErrc::truncated, 0};
+      CHECK_UNARY(decode<int, int>(buffer).contains_err(expected));
+    }
+  }
+  GIVEN("an unknown tag") {
+    auto buffer = bytes({2, 0, 0, 0, 0});
+    THEN("it is rejected") {
+      auto expected = DecodeError {DecodeErrc::invalid_tag, 0};
+      CHECK_UNARY(decode<int, int>(buffer).contains_err(expected));
+    }
+  }
+  GIVEN("two records") {
+    auto buffer = bytes({0, 0});
+    THEN("single record decode reports trailing bytes") {
+      auto expected = DecodeError {DecodeErrc::trailing, 1};
+      CHECK_UNARY(decode<int, void>(buffer).contains_err(expected));
+    }
+  }
+}
+
+SCENARIO("serialize - batches") {
+  GIVEN("a batch of mixed Results") {
+    std::vector<Result<std::string, int>> values;
+    for(int i = 0; i < 100; ++i) {
+      if(i % 3)
+        values.emplace_back(in_place_ok, std::string(i, 'x'));
+      else
+        values.emplace_back(in_place_err, i);
+    }
+    Encoder<std::string, int> encoder;
+    encoder.push(values);
+    WHEN("batch is encoded one by one") {
+      Encoder<std::string, int> single;
+      for(auto &value : values) single.push(value);
+      THEN("output is the same") {
+        CHECK_UNARY(std::ranges::equal(single.bytes(), encoder.bytes()));
+      }
+    }
+    WHEN("it is viewed") {
+      auto batch = BatchView<std::string, int>::parse(encoder.bytes());
+      THEN("records are visited in order without copying") {
+        REQUIRE_UNARY(batch.is_ok());
+        auto &records = batch.ok_value_.value;
+        CHECK_EQ(records.size(), values.size());
+        std::size_t i = 0;
+        for(auto record : records) {
+          REQUIRE_EQ(record.is_ok(), values[i].is_ok());
+          if(record.is_ok())
+            CHECK_EQ(record.ok_value_.value, values[i].ok_value_.value);
+          else
+            CHECK_EQ(record.err_value_.value, values[i].err_value_.value);
+          ++i;
+        }
+        CHECK_EQ(i, values.size());
+      }
+    }
+    WHEN("it is decoded in chunks of every size") {
+      THEN("all records are recovered") {
+        auto all = encoder.bytes();
+        for(std::size_t step : {1, 2, 3, 5, 64, 4096}) {
+          Decoder<std::string, int> decoder;
+          std::vector<Result<std::string, int>> out;
+          for(std::size_t i = 0; i < all.size(); i += step) {
+            auto chunk = all.subspan(i, std::min(step, all.size() - i));
+            auto fed = decoder.feed(chunk, std::back_inserter(out));
+            REQUIRE_UNARY(fed.is_ok());
+          }
+          CHECK_UNARY(decoder.finish().is_ok());
+          REQUIRE_EQ(out.size(), values.size());
+          for(std::size_t j = 0; j < out.size(); ++j) {
+            if(values[j].is_ok())
+              CHECK_UNARY(out[j].contains(values[j].ok_value_.value));
+            else
+              CHECK_UNARY(out[j].contains_err(values[j].err_value_.value));
+          }
+        }
+      }
+    }
+    WHEN("stream ends in the middle of a record") {
+      Decoder<std::string, int> decoder;
+      std::vector<Result<std::string, int>> out;
+      auto all = encoder.bytes();
+      decoder.feed(all.first(all.size() - 1), out);
+      THEN("finish reports truncation at the last record") {
+        CHECK_EQ(out.size(), values.size() - 1);
+        CHECK_UNARY(decoder.finish().is_err());
+        CHECK_GT(decoder.pending(), 0);
+      }
+    }
+  }
+  GIVEN("a batch with a corrupted record") {
+    auto buffer = bytes({1, 1, 0, 0, 0, 9, 0, 0, 0, 0});
+    THEN("view and decoder report its offset") {
+      auto expected = DecodeError {DecodeErrc::invalid_tag, 5};
+      CHECK_UNARY(BatchView<int, int>::parse(buffer).contains_err(expected));
+      Decoder<int, int> decoder;
+      std::vector<Result<int, int>> out;
+      CHECK_UNARY(decoder.feed(buffer, std::back_inserter(out))
+                      .contains_err(expected));
+      CHECK_EQ(out.size(), 1);
+    }
+  }
+}
@@ -0,0 +1,151 @@
+#include "shared_result.hpp"
+#include <doctest/doctest.h>
+
+#include <atomic>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+using namespace sundry;
+
+struct ThrowingPayload {
+  explicit ThrowingPayload(bool fail) {
+    if(fail) throw std::runtime_error("payload");
+  }
+};
+
+/// Throws once \p release is set, announcing construction via \p entered.
+struct GatedPayload {
+  GatedPayload(std::atomic<bool> &entered, std::atomic<bool> &release) {
+    entered = true;
+    while(!release) std::this_thread::yield();
+    throw std::runtime_error("gated payload");
+  }
+};
+
+template<typename S, typename... Args>
+concept CanSetOk = requires(S &slot, Args &&...args) {
+  slot.set_ok(std::forward<Args>(args)...);
+};
+
+static_assert(CanSetOk<SharedResult<long, int>, int>);
+static_assert(!CanSetOk<SharedResult<int *, int>, long>);
+static_assert(!CanSetOk<SharedResult<void, int>, int>);
+
+SCENARIO("SharedResult - single thread") {
+  GIVEN("empty slot") {
+    SharedResult<std::string, int> slot;
+    THEN("it is not ready") {
+      CHECK_UNARY_FALSE(slot.is_ready());
+      CHECK_EQ(slot.try_get(), nullptr);
+    }
+    WHEN("`set_ok(args...)` is called") {
+      REQUIRE_UNARY(slot.set_ok(3, 'x'));
+      THEN("value is constructed in place from args") {
+        REQUIRE_NE(slot.try_get(), nullptr);
+        CHECK_UNARY(slot.try_get()->contains(std::string("xxx")));
+        CHECK_UNARY(slot.wait().contains(std::string("xxx")));
+      }
+      THEN("further sets are rejected") {
+        CHECK_UNARY_FALSE(slot.set_ok("other"));
+        CHECK_UNARY_FALSE(slot.set_err(1));
+        CHECK_UNARY(slot.try_get()->contains(std::string("xxx")));
+      }
+    }
+    WHEN("`set_err(x)` is called") {
+      REQUIRE_UNARY(slot.set_err(7));
+      THEN("error is published") {
+        CHECK_UNARY(slot.is_ready());
+        CHECK_UNARY(slot.try_get()->contains_err(7));
+      }
+    }
+  }
+  GIVEN("slot with void payloads") {
+    SharedResult<void, void> slot;
+    WHEN("`set_ok()` is called") {
+      REQUIRE_UNARY(slot.set_ok());
+      THEN("Ok is published") { CHECK_UNARY(slot.wait().is_ok()); }
+    }
+  }
+  GIVEN("payload whose constructor throws") {
+    SharedResult<ThrowingPayload, int> slot;
+    WHEN("`set_ok` throws") {
+      CHECK_THROWS_AS(slot.set_ok(true), const std::runtime_error &);
+      THEN("slot can still be set") {
+        CHECK_UNARY_FALSE(slot.is_ready());
+        CHECK_UNARY(slot.set_err(1));
+        CHECK_UNARY(slot.try_get()->contains_err(1));
+      }
+    }
+  }
+}
+
+SCENARIO("SharedResult - cross-thread handoff") {
+  GIVEN("several parked waiters") {
+    SharedResult<int, std::string> slot;
+    std::atomic<int> seen {0};
+    std::vector<std::thread> waiters;
+    for(int i = 0; i < 4; ++i)
+      waiters.emplace_back([&] {
+        if(slot.wait(0).contains(42)) ++seen;
+      });
+    WHEN("another thread sets the value") {
+      std::thread setter([&] { slot.set_ok(42); });
+      setter.join();
+      for(auto &t : waiters) t.join();
+      THEN("all waiters observe it") { CHECK_EQ(seen.load(), 4); }
+    }
+  }
+  GIVEN("racing setters") {
+    SharedResult<int, int> slot;
+    std::atomic<int> winners {0};
+    std::vector<std::thread> setters;
+    for(int i = 0; i < 4; ++i)
+      setters.emplace_back([&, i] {
+        if(slot.set_ok(i)) ++winners;
+      });
+    for(auto &t : setters) t.join();
+    THEN("exactly one of them wins") {
+      CHECK_EQ(winners.load(), 1);
+      CHECK_UNARY(slot.wait().is_ok());
+    }
+  }
+  GIVEN("a setter racing with one whose constructor throws") {
+    SharedResult<GatedPayload, int> slot;
+    std::atomic<bool> entered {false}, release {false};
+    std::thread thrower([&] {
+      CHECK_THROWS_AS(slot.set_ok(entered, release),
+                      const std::runtime_error &);
+    });
+    while(!entered) std::this_thread::yield();
+    bool won = false;
+    std::thread setter([&] { won = slot.set_err(1); });
+    release = true;
+    thrower.join();
+    setter.join();
+    THEN("the other setter publishes its value") {
+      CHECK_UNARY(won);
+      CHECK_UNARY(slot.wait().contains_err(1));
+    }
+  }
+  GIVEN("a consumer taking a move-only payload") {
+    SharedResult<std::unique_ptr<int>, int> slot;
+    std::unique_ptr<int> received;
+    std::thread consumer([&] {
+      auto taken = slot.take(0);
+      if(taken.is_ok()) received = std::move(taken.ok_value_.value);
+    });
+    WHEN("the producer publishes it") {
+      slot.set_ok(std::make_unique<int>(7));
+      consumer.join();
+      THEN("ownership moves to the consumer") {
+        REQUIRE_UNARY(received != nullptr);
+        CHECK_EQ(*received, 7);
+        CHECK_UNARY(slot.try_get()->ok_value_.value == nullptr);
+      }
+    }
+  }
+}
@@ -431,4 +431,33 @@ SCENARIO_TEMPLATE("Result - constructor/assignment test, same type", T,
       }
     }
   }
-}
\ No newline at end of file
+}
+
+static_assert(!std::is_constructible_v<Result<long, int>, in_place_ok_t,
+                                       long *>);
+static_assert(!std::is_constructible_v<Result<int, int *>, in_place_err_t,
+                                       long>);
+static_assert(!std::is_constructible_v<Result<void, int>, in_place_ok_t, int>);
+static_assert(std::is_constructible_v<Result<std::string, int>, in_place_ok_t,
+                                      int, char>);
+
+SCENARIO("Result - in-place construction") {
+  GIVEN("constructor arguments of contained types") {
+    WHEN("`in_place_ok` is used") {
+      auto r = Result<std::string, int>(in_place_ok, 3, 'a');
+      THEN("Ok is constructed from them") {
+        CHECK_UNARY(r.contains(std::string("aaa")));
+      }
+    }
+    WHEN("`in_place_err` is used") {
+      auto r = Result<int, std::string>(in_place_err, "bad");
+      THEN("Err is constructed from them") {
+        CHECK_UNARY(r.contains_err(std::string("bad")));
+      }
+    }
+    WHEN("contained type is void") {
+      auto r = Result<void, void>(in_place_err);
+      THEN("void Err is constructed") { CHECK_UNARY(r.is_err()); }
+    }
+  }
+}
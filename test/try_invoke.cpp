@@ -0,0 +1,87 @@
+#include "try_invoke.hpp"
+#include <doctest/doctest.h>
+
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <vector>
+
+using namespace sundry;
+
+namespace {
+  int parse_positive(int value) {
+    if(value < 0) throw std::invalid_argument("negative");
+    return value;
+  }
+
+  struct Custom {};
+}  // namespace
+
+SCENARIO("try_invoke - catching") {
+  GIVEN("a function which does not throw") {
+    THEN("its result is returned as Ok") {
+      CHECK_UNARY(try_invoke(parse_positive, 5).contains(5));
+      auto moved = try_invoke([] { return std::make_unique<int>(3); });
+      REQUIRE_UNARY(moved.is_ok());
+      CHECK_EQ(*moved.ok_value_.value, 3);
+      CHECK_UNARY(try_invoke([] {}).is_ok());
+    }
+  }
+  GIVEN("functions throwing standard exceptions") {
+    THEN("exceptions are mapped to their kind") {
+      CHECK_EQ(try_invoke(parse_positive, -1).unwrap_err().kind,
+               ErrorKind::invalid_argument);
+      CHECK_EQ(try_invoke([] { return std::vector<int>().at(1); })
+                   .unwrap_err()
+                   .kind,
+               ErrorKind::out_of_range);
+      CHECK_EQ(try_invoke([] { throw std::bad_alloc(); }).unwrap_err().kind,
+               ErrorKind::bad_alloc);
+      CHECK_EQ(try_invoke([] { throw std::runtime_error("x"); })
+                   .unwrap_err()
+                   .kind,
+               ErrorKind::runtime_error);
+      CHECK_EQ(try_invoke([] { throw Custom {}; }).unwrap_err().kind,
+               ErrorKind::unknown);
+    }
+    THEN("no exception is kept by default") {
+      CHECK_EQ(try_invoke(parse_positive, -1).unwrap_err().exception, nullptr);
+    }
+  }
+  GIVEN("a function throwing std::system_error") {
+    auto code = std::make_error_code(std::errc::no_such_file_or_directory);
+    auto result = try_invoke([&] { throw std::system_error(code); });
+    THEN("its code is kept") {
+      auto error = result.unwrap_err();
+      CHECK_EQ(error.kind, ErrorKind::system_error);
+      CHECK_EQ(error.error_code(), code);
+    }
+  }
+}
+
+SCENARIO("try_invoke - rethrowing") {
+  GIVEN("an error caught without the exception") {
+    auto error = try_invoke(parse_positive, -1).unwrap_err();
+    THEN("an exception of the same type is synthesized") {
+      CHECK_THROWS_AS(error.rethrow(), const std::invalid_argument &);
+      CHECK_THROWS_AS(
+          value_or_rethrow(try_invoke(parse_positive, -1)),
+          const std::invalid_argument &);
+    }
+  }
+  GIVEN("an error caught with Capture::exception") {
+    auto error =
+        try_invoke<Capture::exception>(parse_positive, -1).unwrap_err();
+    THEN("the original exception is rethrown") {
+      REQUIRE_NE(error.exception, nullptr);
+      CHECK_THROWS_WITH_AS(error.rethrow(), "negative",
+                           const std::invalid_argument &);
+    }
+  }
+  GIVEN("an Ok result") {
+    THEN("value_or_rethrow returns its contents") {
+      CHECK_EQ(value_or_rethrow(try_invoke(parse_positive, 2)), 2);
+    }
+  }
+}
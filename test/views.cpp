@@ -0,0 +1,126 @@
+#include "views.hpp"
+#include <doctest/doctest.h>
+
+#include <ranges>
+#include <string>
+#include <vector>
+
+using namespace sundry;
+
+namespace {
+  using R = Result<int, std::string>;
+
+  std::vector<R> mixed() {
+    std::vector<R> v;
+    v.push_back(make_ok<int, std::string>(1));
+    v.push_back(make_err<int, std::string>("a"));
+    v.push_back(make_ok<int, std::string>(2));
+    v.push_back(make_ok<int, std::string>(3));
+    v.push_back(make_err<int, std::string>("b"));
+    return v;
+  }
+
+  template<std::ranges::range Rng>
+  auto collect(Rng &&rng) {
+    std::vector<std::remove_cvref_t<std::ranges::range_reference_t<Rng>>> out;
+    for(auto &&x : rng) out.push_back(x);
+    return out;
+  }
+}  // namespace
+
+SCENARIO("Result views") {
+  GIVEN("vector mixing Ok and Err") {
+    auto input = mixed();
+    WHEN("`oks` is applied") {
+      auto view = input | views::oks;
+      THEN("Ok payloads are yielded by reference") {
+        auto expected = std::vector<int> {1, 2, 3};
+        CHECK_EQ(collect(view), expected);
+        static_assert(
+            std::is_same_v<std::ranges::range_reference_t<decltype(view)>,
+                           int &>);
+        for(auto &x : view) x *= 10;
+        CHECK_UNARY(input[0].contains(10));
+      }
+    }
+    WHEN("`errs` is applied") {
+      THEN("Err payloads are yielded") {
+        auto expected = std::vector<std::string> {"a", "b"};
+        CHECK_EQ(collect(input | views::errs), expected);
+      }
+    }
+    WHEN("`take_until_err` is applied") {
+      THEN("only leading Oks are yielded") {
+        auto out = collect(input | views::take_until_err | views::oks);
+        REQUIRE_EQ(out.size(), 1);
+        CHECK_EQ(out[0], 1);
+      }
+    }
+    WHEN("`transform_ok` is applied") {
+      auto view = input | views::transform_ok([](int x) { return x * 2.5; });
+      THEN("Oks are mapped and Errs are kept") {
+        auto oks = std::vector<double> {2.5, 5, 7.5};
+        auto errs = std::vector<std::string> {"a", "b"};
+        CHECK_EQ(collect(view | views::oks), oks);
+        CHECK_EQ(collect(view | views::errs), errs);
+      }
+    }
+    WHEN("`and_then` is applied") {
+      auto view = input | views::and_then([](int x) -> R {
+                    if(x == 2) return Err<std::string> {"two"};
+                    return Ok<int> {-x};
+                  });
+      THEN("Ok payloads may turn into Errs") {
+        auto oks = std::vector<int> {-1, -3};
+        auto errs = std::vector<std::string> {"a", "two", "b"};
+        CHECK_EQ(collect(view | views::oks), oks);
+        CHECK_EQ(collect(view | views::errs), errs);
+      }
+    }
+    WHEN("`filter_ok` is applied") {
+      THEN("Oks failing the predicate are dropped") {
+        auto view = input | views::filter_ok([](int x) { return x != 2; });
+        CHECK_EQ(std::ranges::distance(view), 4);
+        auto expected = std::vector<int> {1, 3};
+        CHECK_EQ(collect(view | views::oks), expected);
+      }
+    }
+    WHEN("combined with standard views") {
+      THEN("adaptors compose") {
+        auto out = collect(input | std::views::reverse | views::oks
+                           | std::views::take(2));
+        auto expected = std::vector<int> {3, 2};
+        CHECK_EQ(out, expected);
+      }
+    }
+  }
+  GIVEN("lazily generated stream") {
+    auto stream = std::views::iota(0, 1000000)
+                  | std::views::transform([](int i) -> Result<int, int> {
+                      if(i % 3 == 0) return Err<int> {i};
+                      return Ok<int> {i};
+                    });
+    WHEN("views are chained") {
+      long long sum = 0;
+      for(auto x : stream | views::transform_ok([](int i) { return i % 2; })
+                       | views::oks)
+        sum += x;
+      THEN("elements are processed without materialization") {
+        CHECK_EQ(sum, 333333);
+      }
+    }
+  }
+  GIVEN("Results with void payloads") {
+    std::vector<Result<void, int>> input;
+    input.push_back(make_ok<void, int>());
+    input.push_back(make_err<void, int>(4));
+    WHEN("`transform_ok` is applied") {
+      auto out = collect(input | views::transform_ok([] { return 1; }));
+      THEN("callable is invoked without arguments") {
+        REQUIRE_EQ(out.size(), 2);
+        CHECK_UNARY(out[0].contains(1));
+        CHECK_UNARY(out[1].contains_err(4));
+      }
+    }
+  }
+}